@@ -0,0 +1,115 @@
+/**
+ * @file agendamento.cpp
+ * @brief Implementação da geração do agendamento de cada corretor
+ */
+
+#include "agendamento.h"
+#include "geografia.h"
+#include <array>
+#include <stdexcept>
+
+/**
+ * Converte minutos desde o início do dia (09:00) para formato hora:minuto
+ */
+std::pair<int, int> minutosParaHoraMinuto(int minutos) {
+    int totalMinutos = HORA_INICIO * 60 + MINUTOS_INICIO + minutos;
+    int hora = totalMinutos / 60;
+    int minuto = totalMinutos % 60;
+    return {hora, minuto};
+}
+
+namespace {
+
+using GeradorAgenda = std::vector<Agendamento> (*)(const std::vector<Imovel>&, const Corretor&, FaixaImoveis,
+                                                   const ConfiguracaoRota&, EstatisticasDistancia*);
+
+/**
+ * Instâncias de gerarAgendamentoCorretor de um provedor, na ordem de ModeloTempo
+ */
+template <typename Provedor>
+constexpr std::array<GeradorAgenda, 2> instanciasTempo() {
+    static_assert(TempoFixo::modelo == ModeloTempo::Fixo && TempoPorTipo::modelo == ModeloTempo::PorTipo);
+    return {&gerarAgendamentoCorretor<Provedor, TempoFixo>, &gerarAgendamentoCorretor<Provedor, TempoPorTipo>};
+}
+
+// Tabela de despacho: uma linha por TipoDistancia (na ordem do enum), uma coluna por ModeloTempo
+constexpr std::array<std::array<GeradorAgenda, 2>, 4> TABELA_ROTAS = {
+    instanciasTempo<ProvedorHaversine>(),
+    instanciasTempo<ProvedorCache>(),
+    instanciasTempo<ProvedorEquiretangular>(),
+    instanciasTempo<ProvedorRede>(),
+};
+static_assert(static_cast<int>(TipoDistancia::Haversine) == 0 && static_cast<int>(TipoDistancia::Cache) == 1 &&
+              static_cast<int>(TipoDistancia::Equiretangular) == 2 && static_cast<int>(TipoDistancia::Rede) == 3,
+              "TABELA_ROTAS segue a ordem de TipoDistancia");
+
+} // namespace
+
+/**
+ * Converte o nome usado em --service-time
+ */
+ModeloTempo modeloTempoPorNome(const std::string& nome) {
+    if (nome == "fixed") {
+        return ModeloTempo::Fixo;
+    } else if (nome == "bytype") {
+        return ModeloTempo::PorTipo;
+    }
+    throw std::runtime_error("Erro: valor inválido para --service-time: " + nome + " (use fixed ou bytype)");
+}
+
+/**
+ * Converte o nome usado em --route
+ */
+HeuristicaRota heuristicaRotaPorNome(const std::string& nome) {
+    if (nome == "nn") {
+        return HeuristicaRota::VizinhoMaisProximo;
+    } else if (nome == "sfc") {
+        return HeuristicaRota::Curva;
+    }
+    throw std::runtime_error("Erro: valor inválido para --route: " + nome + " (use nn ou sfc)");
+}
+
+/**
+ * Gera o agendamento otimizado para um corretor
+ * 
+ * Despacha para a instância com as políticas de distância e de tempo da
+ * configuração; dentro dela, nenhuma chamada do laço da rota é virtual.
+ */
+std::vector<Agendamento> gerarAgendamentoCorretor(const std::vector<Imovel>& imoveis,
+                                                  const Corretor& corretor,
+                                                  FaixaImoveis imoveisCorretor,
+                                                  const ConfiguracaoRota& configuracao,
+                                                  EstatisticasDistancia* estatisticas) {
+    GeradorAgenda gerar = TABELA_ROTAS[static_cast<int>(configuracao.distancia)][static_cast<int>(configuracao.tempo)];
+    return gerar(imoveis, corretor, imoveisCorretor, configuracao, estatisticas);
+}
+
+/**
+ * Calcula a distância total percorrida por um corretor no agendamento gerado
+ */
+double distanciaPercorrida(const std::vector<Imovel>& imoveis, const Corretor& corretor,
+                           const std::vector<Agendamento>& agendamentos) {
+    double total = 0.0;
+    double latAtual = corretor.latitude;
+    double lonAtual = corretor.longitude;
+    for (const auto& agendamento : agendamentos) {
+        const Imovel& imovel = imoveis[agendamento.imovelId - 1];
+        total += haversine(latAtual, lonAtual, imovel.latitude, imovel.longitude);
+        latAtual = imovel.latitude;
+        lonAtual = imovel.longitude;
+    }
+    return total;
+}
+
+/**
+ * Fim da última visita: horário de início mais a duração da avaliação
+ */
+int terminoAgenda(const std::vector<Imovel>& imoveis, const std::vector<Agendamento>& agendamentos,
+                  ModeloTempo tempo) {
+    if (agendamentos.empty()) {
+        return 0;
+    }
+    const Agendamento& ultima = agendamentos.back();
+    int inicio = ultima.hora * 60 + ultima.minuto - (HORA_INICIO * 60 + MINUTOS_INICIO);
+    return inicio + duracaoAvaliacao(tempo, imoveis[ultima.imovelId - 1].tipo);
+}
@@ -0,0 +1,369 @@
+/**
+ * @file agendamento.h
+ * @brief Geração do agendamento de visitas de cada corretor avaliador
+ * 
+ * A geração acontece em duas etapas: primeiro define-se a ordem das visitas
+ * (vizinho mais próximo ou curva de Hilbert, opcionalmente melhorada por
+ * busca local e calculada sobre paradas que agrupam imóveis vizinhos) e depois
+ * calculam-se os horários a partir dessa ordem.
+ * 
+ * As etapas são modelos sobre duas políticas: a de distância (um provedor
+ * concreto de distancia.h) e a de tempo (TempoFixo ou TempoPorTipo). Cada
+ * combinação gera um laço próprio, com as chamadas expandidas; a versão sem
+ * modelo de gerarAgendamentoCorretor escolhe a instância numa tabela de
+ * despacho a partir de ConfiguracaoRota (--distance e --service-time).
+ */
+
+#ifndef AGENDAMENTO_H
+#define AGENDAMENTO_H
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "atribuicao.h"
+#include "coordenadas.h"
+#include "corretor.h"
+#include "curva.h"
+#include "distancia.h"
+#include "imovel.h"
+#include "indice_espacial.h"
+#include "melhoria.h"
+#include "paradas.h"
+#include "rota_exata.h"
+
+constexpr int HORA_INICIO = 9;     // Hora de início das avaliações
+constexpr int MINUTOS_INICIO = 0;  // Minuto de início
+constexpr int DURACAO_AVALIACAO = 60; // Duração da avaliação em minutos
+constexpr double TEMPO_DESLOCAMENTO_POR_KM = 2.0; // Minutos por km
+
+/**
+ * Estrutura para armazenar informações de um agendamento
+ */
+struct Agendamento {
+    int hora;
+    int minuto;
+    int imovelId;
+    
+    Agendamento(int h, int m, int id) : hora(h), minuto(m), imovelId(id) {}
+};
+
+/**
+ * Regra de duração das visitas (--service-time)
+ */
+enum class ModeloTempo {
+    Fixo,   ///< 1 hora por avaliação, como no enunciado
+    PorTipo ///< Duração conforme o tipo do imóvel (TempoPorTipo)
+};
+
+/**
+ * Política de tempo do enunciado: 2 min/km de deslocamento (truncado) e
+ * 1 hora por avaliação
+ */
+struct TempoFixo {
+    static constexpr ModeloTempo modelo = ModeloTempo::Fixo;
+    static constexpr int deslocamento(double km) { return static_cast<int>(km * TEMPO_DESLOCAMENTO_POR_KM); }
+    static constexpr int avaliacao(TipoImovel) { return DURACAO_AVALIACAO; }
+};
+
+/**
+ * Deslocamento como em TempoFixo; avaliação de 60 min para casas, 45 para
+ * apartamentos e 30 para terrenos
+ */
+struct TempoPorTipo {
+    static constexpr ModeloTempo modelo = ModeloTempo::PorTipo;
+    static constexpr int deslocamento(double km) { return TempoFixo::deslocamento(km); }
+    static constexpr int avaliacao(TipoImovel tipo) {
+        return tipo == Casa ? 60 : (tipo == Apartamento ? 45 : 30);
+    }
+};
+
+/**
+ * Duração da avaliação de um imóvel no modelo dado, para quem escolhe o
+ * modelo em tempo de execução (modo serviço)
+ */
+inline int duracaoAvaliacao(ModeloTempo modelo, TipoImovel tipo) {
+    return modelo == ModeloTempo::PorTipo ? TempoPorTipo::avaliacao(tipo) : TempoFixo::avaliacao(tipo);
+}
+
+/**
+ * Converte o nome usado em --service-time ("fixed", "bytype")
+ * @throws std::runtime_error se o nome não for reconhecido
+ */
+ModeloTempo modeloTempoPorNome(const std::string& nome);
+
+/**
+ * Heurística que define a ordem das visitas (--route)
+ */
+enum class HeuristicaRota {
+    VizinhoMaisProximo, ///< Vizinho mais próximo com índice espacial, como no enunciado
+    Curva               ///< Ordem da curva de Hilbert, O(n log n) (ver curva.h)
+};
+
+/**
+ * Converte o nome usado em --route ("nn", "sfc")
+ * @throws std::runtime_error se o nome não for reconhecido
+ */
+HeuristicaRota heuristicaRotaPorNome(const std::string& nome);
+
+/**
+ * Parâmetros opcionais da geração de rotas. Os valores padrão reproduzem
+ * exatamente o algoritmo do enunciado.
+ */
+struct ConfiguracaoRota {
+    HeuristicaRota heuristica = HeuristicaRota::VizinhoMaisProximo; ///< Ordem inicial das visitas (--route)
+    int melhoriaMs = 0; ///< Tempo (ms) de 2-opt/Or-opt por corretor; 0 desliga
+    TipoDistancia distancia = TipoDistancia::Haversine; ///< Provedor de distâncias da rota
+    const RedeViaria* rede = nullptr; ///< Malha viária de TipoDistancia::Rede (--road-network)
+    ModeloTempo tempo = ModeloTempo::Fixo; ///< Duração das visitas (--service-time)
+    int exatoAte = 0;     ///< Rotas com até N imóveis recebem o caminho ótimo (--exact-max N); 0 desliga
+    int threadsExato = 1; ///< Threads de cada programação dinâmica do caminho ótimo
+    bool manterOrdem = false; ///< Visita os imóveis na ordem recebida (rotas já otimizadas, ver rebalanceamento.h)
+    double raioParadasM = -1.0; ///< Agrupa imóveis a até M metros numa parada (--collapse-m M, ver paradas.h); negativo desliga
+};
+
+/**
+ * Converte minutos desde o início do dia (09:00) para formato hora:minuto
+ * 
+ * @param minutos Minutos desde 09:00
+ * @return Par (hora, minuto) no formato 24h
+ */
+std::pair<int, int> minutosParaHoraMinuto(int minutos);
+
+/**
+ * Encontra o imóvel mais próximo não visitado para um corretor
+ * 
+ * Os imóveis visitados já foram removidos do índice, então a consulta
+ * considera apenas os pendentes. Com o provedor haversine, o resultado é
+ * idêntico ao da varredura linear: menor distância e, em caso de empate, o
+ * primeiro da lista.
+ * 
+ * @tparam Provedor Política de distância (provedor concreto de distancia.h)
+ * @param indice Índice espacial com os imóveis ainda não visitados
+ * @param provedor Provedor de distâncias da rota
+ * @param noAtual Nó do ponto atual (0 = corretor, p + 1 = imóvel na posição p)
+ * @param latAtual Latitude atual do corretor
+ * @param lonAtual Longitude atual do corretor
+ * @param distancia Recebe a distância em km até o imóvel encontrado
+ * @return Posição do imóvel na lista do corretor, ou -1 se não houver mais imóveis
+ */
+template <typename Provedor>
+int encontrarImovelMaisProximo(const IndiceEspacial& indice, Provedor& provedor,
+                               int noAtual, double latAtual, double lonAtual,
+                               double& distancia) {
+    return indice.maisProximo(latAtual, lonAtual,
+                              [&](int posicao) { return provedor.distancia(noAtual, posicao + 1); },
+                              provedor.margemRelativa(), distancia);
+}
+
+/**
+ * Ordena as visitas pelo algoritmo do vizinho mais próximo
+ * 
+ * O índice espacial é construído uma única vez por corretor e cada imóvel
+ * visitado é removido dele, tornando cada passo O(log n) em média.
+ * 
+ * @param pontos Coordenadas dos imóveis do corretor
+ * @param latInicio Latitude de partida (localização do corretor)
+ * @param lonInicio Longitude de partida
+ * @param provedor Provedor de distâncias da rota
+ * @return Posições (em pontos) na ordem de visita
+ */
+template <typename Provedor>
+std::vector<int> rotaVizinhoMaisProximo(const BlocoCoordenadas& pontos, double latInicio, double lonInicio,
+                                        Provedor& provedor) {
+    std::vector<int> rota;
+    rota.reserve(pontos.tamanho());
+    IndiceEspacial indice(pontos);
+    
+    int noAtual = 0;
+    double latAtual = latInicio;
+    double lonAtual = lonInicio;
+    
+    while (indice.tamanho() > 0) {
+        double distancia = 0.0;
+        int posicao = encontrarImovelMaisProximo(indice, provedor, noAtual, latAtual, lonAtual, distancia);
+        
+        if (posicao == -1) {
+            throw std::runtime_error("Erro: não foi possível encontrar próximo imóvel");
+        }
+        rota.push_back(posicao);
+        
+        // Atualizar posição atual e marcar como visitado
+        noAtual = posicao + 1;
+        latAtual = pontos.latitude[posicao];
+        lonAtual = pontos.longitude[posicao];
+        indice.remover(posicao);
+    }
+    
+    return rota;
+}
+
+/**
+ * Calcula os horários das visitas a partir da ordem da rota
+ * 
+ * Cada deslocamento usa o mesmo provedor (e, portanto, o mesmo valor) da
+ * escolha do vizinho mais próximo; com o provedor de cache, a distância já
+ * calculada na busca é reaproveitada.
+ * 
+ * @tparam Tempo Política de tempo (TempoFixo ou TempoPorTipo)
+ * @param imoveis Lista de todos os imóveis (para o tipo de cada um)
+ * @param imoveisCorretor IDs dos imóveis, na ordem do bloco de coordenadas da rota
+ * @param rota Posições na ordem de visita
+ * @param provedor Provedor de distâncias da rota
+ * @return Lista de agendamentos ordenados por horário
+ */
+template <typename Tempo, typename Provedor>
+std::vector<Agendamento> calcularAgendamentos(const std::vector<Imovel>& imoveis,
+                                              FaixaImoveis imoveisCorretor,
+                                              const std::vector<int>& rota,
+                                              Provedor& provedor) {
+    std::vector<Agendamento> agendamentos;
+    agendamentos.reserve(rota.size());
+    
+    int noAtual = 0;  // localização do corretor
+    int tempoAtual = 0; // minutos desde 09:00
+    
+    for (int posicao : rota) {
+        tempoAtual += Tempo::deslocamento(provedor.distancia(noAtual, posicao + 1));
+        
+        auto [hora, minuto] = minutosParaHoraMinuto(tempoAtual);
+        int imovelId = imoveisCorretor[posicao];
+        agendamentos.emplace_back(hora, minuto, imovelId);
+        
+        noAtual = posicao + 1;
+        tempoAtual += Tempo::avaliacao(imoveis[imovelId - 1].tipo);
+    }
+    
+    return agendamentos;
+}
+
+/**
+ * Ordena as visitas de um conjunto de pontos: pelo caminho ótimo (até
+ * configuracao.exatoAte pontos) ou pela heurística de configuracao.heuristica,
+ * seguida da busca local se configurada
+ *
+ * @tparam Provedor Política de distância, construída sobre pontos (nó 0 = corretor)
+ * @return Posições (em pontos) na ordem de visita
+ */
+template <typename Provedor>
+std::vector<int> ordenarVisitas(const BlocoCoordenadas& pontos, const Corretor& corretor,
+                                const ConfiguracaoRota& configuracao, Provedor& provedor) {
+    int n = static_cast<int>(pontos.tamanho());
+    if (n <= configuracao.exatoAte) {
+        return rotaExata(n, provedor, configuracao.threadsExato); // ótimo: a busca local não teria o que melhorar
+    }
+    std::vector<int> rota = configuracao.heuristica == HeuristicaRota::Curva
+        ? rotaCurva(pontos, corretor.latitude, corretor.longitude, provedor)
+        : rotaVizinhoMaisProximo(pontos, corretor.latitude, corretor.longitude, provedor);
+    if (configuracao.melhoriaMs > 0) {
+        melhorarRota(pontos, rota, configuracao.melhoriaMs, provedor);
+    }
+    return rota;
+}
+
+/**
+ * Gera o agendamento de um corretor com as políticas fixadas em compilação
+ * 
+ * Monta o bloco de coordenadas do corretor, ordena as visitas
+ * (ordenarVisitas, ou na ordem recebida, com configuracao.manterOrdem) e
+ * calcula os horários, todas as etapas usando o mesmo provedor de
+ * distâncias. Com configuracao.raioParadasM >= 0, a ordem é calculada
+ * sobre as paradas (paradas.h), com um provedor próprio, e os horários,
+ * sobre os imóveis.
+ * 
+ * @tparam Provedor Política de distância (deve corresponder a configuracao.distancia)
+ * @tparam Tempo Política de tempo (deve corresponder a configuracao.tempo)
+ */
+template <typename Provedor, typename Tempo>
+std::vector<Agendamento> gerarAgendamentoCorretor(const std::vector<Imovel>& imoveis,
+                                                  const Corretor& corretor,
+                                                  FaixaImoveis imoveisCorretor,
+                                                  const ConfiguracaoRota& configuracao,
+                                                  EstatisticasDistancia* estatisticas) {
+    // Bloco contíguo (SoA) com as coordenadas e os valores trigonométricos pré-calculados
+    BlocoCoordenadas pontos;
+    pontos.reservar(imoveisCorretor.tamanho());
+    for (int imovelId : imoveisCorretor) {
+        pontos.adicionar(imoveis[imovelId - 1].latitude, imoveis[imovelId - 1].longitude); // IDs começam em 1, índices em 0
+    }
+    auto criarProvedor = [&](const BlocoCoordenadas& bloco) {
+        if constexpr (std::is_same_v<Provedor, ProvedorRede>) {
+            return ProvedorRede(bloco, corretor.latitude, corretor.longitude, configuracao.rede);
+        } else {
+            return Provedor(bloco, corretor.latitude, corretor.longitude);
+        }
+    };
+    Provedor provedor = criarProvedor(pontos);
+    
+    std::vector<int> rota;
+    int n = static_cast<int>(pontos.tamanho());
+    int paradasRoteadas = n;
+    if (configuracao.manterOrdem) {
+        rota.resize(n);
+        std::iota(rota.begin(), rota.end(), 0);
+    } else if (configuracao.raioParadasM >= 0.0) {
+        ParadasRota paradas = agruparParadas(pontos, configuracao.raioParadasM);
+        Provedor provedorParadas = criarProvedor(paradas.pontos);
+        rota = paradas.expandir(ordenarVisitas(paradas.pontos, corretor, configuracao, provedorParadas));
+        paradasRoteadas = paradas.numParadas();
+        if (estatisticas) {
+            *estatisticas += provedorParadas.estatisticas();
+        }
+    } else {
+        rota = ordenarVisitas(pontos, corretor, configuracao, provedor);
+    }
+    
+    std::vector<Agendamento> agendamentos = calcularAgendamentos<Tempo>(imoveis, imoveisCorretor, rota, provedor);
+    if (estatisticas) {
+        *estatisticas += provedor.estatisticas();
+        estatisticas->imoveis += n;
+        estatisticas->paradas += paradasRoteadas;
+    }
+    return agendamentos;
+}
+
+/**
+ * Gera o agendamento otimizado para um corretor usando o algoritmo
+ * do vizinho mais próximo
+ * 
+ * Escolhe na tabela de despacho a instância de gerarAgendamentoCorretor
+ * correspondente a configuracao.distancia e configuracao.tempo.
+ * 
+ * @param imoveis Lista de todos os imóveis
+ * @param corretor Corretor para o qual gerar o agendamento
+ * @param imoveisCorretor IDs dos imóveis atribuídos ao corretor (Atribuicao::imoveisDe)
+ * @param configuracao Etapas opcionais de otimização da rota
+ * @param estatisticas Se não for nulo, recebe (somando) o uso do provedor de distâncias
+ * @return Lista de agendamentos ordenados por horário
+ */
+std::vector<Agendamento> gerarAgendamentoCorretor(const std::vector<Imovel>& imoveis,
+                                                  const Corretor& corretor,
+                                                  FaixaImoveis imoveisCorretor,
+                                                  const ConfiguracaoRota& configuracao = ConfiguracaoRota(),
+                                                  EstatisticasDistancia* estatisticas = nullptr);
+
+/**
+ * Calcula a distância total percorrida por um corretor no agendamento gerado
+ * 
+ * @param imoveis Lista de todos os imóveis
+ * @param corretor Corretor dono do agendamento
+ * @param agendamentos Visitas na ordem em que acontecem
+ * @return Soma das distâncias (km) desde a localização do corretor até o último imóvel
+ */
+double distanciaPercorrida(const std::vector<Imovel>& imoveis, const Corretor& corretor,
+                           const std::vector<Agendamento>& agendamentos);
+
+/**
+ * Calcula o fim da última visita de um agendamento
+ * 
+ * @param imoveis Lista de todos os imóveis (para o tipo do último)
+ * @param agendamentos Visitas na ordem em que acontecem
+ * @param tempo Modelo da duração das visitas
+ * @return Minutos desde 09:00 até o fim da última avaliação (0 se não houver visitas)
+ */
+int terminoAgenda(const std::vector<Imovel>& imoveis, const std::vector<Agendamento>& agendamentos,
+                  ModeloTempo tempo);
+
+#endif
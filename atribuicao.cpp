@@ -0,0 +1,237 @@
+/**
+ * @file atribuicao.cpp
+ * @brief Implementação das estratégias de distribuição dos imóveis
+ */
+
+#include "atribuicao.h"
+#include "coordenadas.h"
+#include "curva.h"
+#include "geografia.h"
+#include "indice_espacial.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+constexpr int ITERACOES_CLUSTER = 8; // Máximo de iterações do k-means balanceado
+
+/**
+ * Converte um vetor 3D (não necessariamente unitário) para latitude/longitude em graus
+ * 
+ * Mantém o valor anterior se o vetor for praticamente nulo (membros em
+ * lados opostos do globo se cancelando).
+ */
+void paraGeografico(const double xyz[3], double& lat, double& lon) {
+    double norma = std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+    if (norma < 1e-12) {
+        return;
+    }
+    lat = std::asin(std::max(-1.0, std::min(1.0, xyz[2] / norma))) * 180.0 / M_PI;
+    lon = std::atan2(xyz[1], xyz[0]) * 180.0 / M_PI;
+}
+
+} // namespace
+
+/**
+ * @brief Distribui os imóveis entre os avaliadores segundo o modo escolhido
+ */
+Atribuicao atribuirImoveis(const std::vector<Imovel>& imoveis,
+                           const std::vector<const Corretor*>& avaliadores,
+                           ModoAtribuicao modo, int threads) {
+    if (modo == ModoAtribuicao::Cluster) {
+        return atribuirCluster(imoveis, avaliadores, threads);
+    }
+    return atribuirRoundRobin(imoveis, avaliadores);
+}
+
+/**
+ * @brief Lista os corretores avaliadores e confere se há o que agendar
+ */
+std::vector<const Corretor*> selecionarAvaliadores(const std::vector<Corretor>& corretores,
+                                                   const std::vector<Imovel>& imoveis) {
+    std::vector<const Corretor*> avaliadores;
+    for (const auto& corretor : corretores) {
+        if (corretor.isAvaliador()) {
+            avaliadores.push_back(&corretor);
+        }
+    }
+    if (avaliadores.empty()) {
+        throw std::runtime_error("Erro: não há corretores avaliadores");
+    }
+    if (imoveis.empty()) {
+        throw std::runtime_error("Erro: não há imóveis para avaliar");
+    }
+    return avaliadores;
+}
+
+/**
+ * @brief Distribuição Round-Robin: imóvel i para o avaliador i % k
+ */
+Atribuicao atribuirRoundRobin(const std::vector<Imovel>& imoveis, const std::vector<const Corretor*>& avaliadores) {
+    int n = static_cast<int>(imoveis.size());
+    Atribuicao atribuicao = reservarRoundRobin(n, avaliadores);
+    // A vez de cada imóvel é a do seu ID na entrada, mesmo com a base reordenada (curva.h)
+    for (int i = 0; i < n; ++i) {
+        colocarRoundRobin(atribuicao, imoveis[i].id - 1, i + 1);
+    }
+    return atribuicao;
+}
+
+/**
+ * @brief Faixas do Round-Robin: os n % k primeiros avaliadores recebem um imóvel a mais
+ */
+Atribuicao reservarRoundRobin(int numImoveis, const std::vector<const Corretor*>& avaliadores) {
+    int n = numImoveis;
+    int k = static_cast<int>(avaliadores.size());
+    Atribuicao atribuicao;
+    atribuicao.avaliadores = avaliadores;
+    atribuicao.inicio.resize(k + 1, 0);
+    for (int j = 0; j < k; ++j) {
+        atribuicao.inicio[j + 1] = atribuicao.inicio[j] + n / k + (j < n % k ? 1 : 0);
+    }
+    atribuicao.imoveis.resize(n);
+    return atribuicao;
+}
+
+/**
+ * @brief Distribuição por k-means balanceado por capacidade
+ * 
+ * A busca dos dois centros mais próximos de cada imóvel roda em paralelo;
+ * a atribuição gulosa com capacidade é sequencial e determinística (empates
+ * resolvidos pelo índice do imóvel), então o resultado não depende do
+ * número de threads.
+ */
+Atribuicao atribuirCluster(const std::vector<Imovel>& imoveis, const std::vector<const Corretor*>& avaliadores,
+                           int threads) {
+    int n = static_cast<int>(imoveis.size());
+    int k = static_cast<int>(avaliadores.size());
+
+    // Mesma cota de cada avaliador no Round-Robin
+    std::vector<int> capacidade(k, n / k);
+    for (int j = 0; j < n % k; ++j) {
+        capacidade[j]++;
+    }
+
+    BlocoCoordenadas pontos;
+    pontos.reservar(n);
+    for (const auto& imovel : imoveis) {
+        pontos.adicionar(imovel.latitude, imovel.longitude);
+    }
+
+    std::vector<double> centroLat(k), centroLon(k);
+    for (int j = 0; j < k; ++j) {
+        centroLat[j] = avaliadores[j]->latitude;
+        centroLon[j] = avaliadores[j]->longitude;
+    }
+
+    std::vector<int> grupo(n, -1);
+    std::vector<int> maisProximo(n);
+    std::vector<double> arrependimento(n);
+    std::vector<std::pair<double, int>> ordem(n);
+    int blocos = std::max(1, threads) * 4;
+
+    for (int iteracao = 0; iteracao < ITERACOES_CLUSTER; ++iteracao) {
+        BlocoCoordenadas centros;
+        centros.reservar(k);
+        for (int j = 0; j < k; ++j) {
+            centros.adicionar(centroLat[j], centroLon[j]);
+        }
+        IndiceEspacial indiceCentros(centros);
+
+        // 1. Dois centros mais próximos de cada imóvel (em paralelo)
+        executarEmParalelo(blocos, threads, [&](int b) {
+            std::vector<int> posicoes;
+            std::vector<double> distancias;
+            int inicio = static_cast<int>(static_cast<long long>(n) * b / blocos);
+            int fim = static_cast<int>(static_cast<long long>(n) * (b + 1) / blocos);
+            for (int i = inicio; i < fim; ++i) {
+                indiceCentros.kMaisProximos(pontos.latitude[i], pontos.longitude[i], 2, posicoes, distancias);
+                maisProximo[i] = posicoes[0];
+                arrependimento[i] = posicoes.size() > 1 ? distancias[1] - distancias[0] : 0.0;
+            }
+        });
+
+        // 2. Atribuição gulosa: quem mais perde ao não ficar no centro preferido escolhe primeiro
+        //    (chave negada para ordenar de forma crescente pares contíguos)
+        //    (empates pelo ID da entrada, para não depender de --reorder)
+        for (int i = 0; i < n; ++i) {
+            ordem[i] = {-arrependimento[i], i};
+        }
+        std::sort(ordem.begin(), ordem.end(), [&](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+            return a.first != b.first ? a.first < b.first : imoveis[a.second].id < imoveis[b.second].id;
+        });
+
+        IndiceEspacial centrosLivres(centros);
+        std::vector<int> restante = capacidade;
+        for (int j = 0; j < k; ++j) {
+            if (restante[j] == 0) {
+                centrosLivres.remover(j);
+            }
+        }
+        int mudancas = 0;
+        for (const auto& [chave, i] : ordem) {
+            int j = maisProximo[i];
+            if (restante[j] == 0) {
+                double distancia;
+                j = centrosLivres.maisProximo(pontos.latitude[i], pontos.longitude[i], distancia);
+            }
+            if (--restante[j] == 0) {
+                centrosLivres.remover(j);
+            }
+            if (grupo[i] != j) {
+                grupo[i] = j;
+                mudancas++;
+            }
+        }
+        if (mudancas == 0) {
+            break;
+        }
+
+        // 3. Novo centro: média dos membros na esfera unitária, incluindo a
+        //    localização do avaliador, ponto de partida da rota
+        std::vector<double> soma(3 * k, 0.0);
+        for (int j = 0; j < k; ++j) {
+            double xyz[3];
+            paraCartesiano(avaliadores[j]->latitude, avaliadores[j]->longitude, xyz);
+            soma[3 * j] = xyz[0];
+            soma[3 * j + 1] = xyz[1];
+            soma[3 * j + 2] = xyz[2];
+        }
+        for (int i = 0; i < n; ++i) {
+            soma[3 * grupo[i]] += pontos.x[i];
+            soma[3 * grupo[i] + 1] += pontos.y[i];
+            soma[3 * grupo[i] + 2] += pontos.sinLat[i];
+        }
+        for (int j = 0; j < k; ++j) {
+            paraGeografico(&soma[3 * j], centroLat[j], centroLon[j]);
+        }
+    }
+
+    // Ordenação por contagem: percorrer os imóveis em ordem mantém cada
+    // grupo em ordem crescente de ID (com a base reordenada, os grupos são
+    // reordenados pelo ID da entrada, como na distribuição Round-Robin)
+    Atribuicao atribuicao;
+    atribuicao.avaliadores = avaliadores;
+    atribuicao.inicio.assign(k + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        atribuicao.inicio[grupo[i] + 1]++;
+    }
+    for (int j = 0; j < k; ++j) {
+        atribuicao.inicio[j + 1] += atribuicao.inicio[j];
+    }
+    std::vector<std::uint32_t> proxima(atribuicao.inicio.begin(), atribuicao.inicio.end() - 1);
+    atribuicao.imoveis.resize(n);
+    for (int i = 0; i < n; ++i) {
+        atribuicao.imoveis[proxima[grupo[i]]++] = i + 1;
+    }
+    if (baseReordenada(imoveis)) {
+        for (int j = 0; j < k; ++j) {
+            std::sort(atribuicao.imoveis.begin() + atribuicao.inicio[j],
+                      atribuicao.imoveis.begin() + atribuicao.inicio[j + 1],
+                      [&](int a, int b) { return imoveis[a - 1].id < imoveis[b - 1].id; });
+        }
+    }
+    return atribuicao;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file atribuicao.h
+ * @brief Estratégias de distribuição dos imóveis entre os corretores avaliadores
+ * 
+ * A distribuição padrão é a Round-Robin do enunciado. A alternativa por
+ * agrupamento espacial mantém a mesma quantidade de imóveis por avaliador,
+ * mas entrega a cada um imóveis próximos entre si e da sua localização.
+ */
+
+#ifndef ATRIBUICAO_H
+#define ATRIBUICAO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "corretor.h"
+#include "imovel.h"
+
+/**
+ * @enum ModoAtribuicao
+ * @brief Estratégia usada para distribuir os imóveis
+ */
+enum class ModoAtribuicao {
+    RoundRobin, ///< Imóvel i para o avaliador i % k (enunciado)
+    Cluster     ///< k-means balanceado, semeado pela localização dos avaliadores
+};
+
+/**
+ * @struct FaixaImoveis
+ * @brief IDs dos imóveis de um avaliador: um trecho de Atribuicao::imoveis
+ */
+struct FaixaImoveis {
+    const int* primeiro = nullptr;
+    const int* ultimo = nullptr;
+
+    const int* begin() const { return primeiro; }
+    const int* end() const { return ultimo; }
+    std::size_t tamanho() const { return static_cast<std::size_t>(ultimo - primeiro); }
+    bool vazia() const { return primeiro == ultimo; }
+    int operator[](std::size_t i) const { return primeiro[i]; }
+};
+
+/**
+ * @struct Atribuicao
+ * @brief Imóveis de todos os avaliadores em formato CSR
+ * 
+ * Um único vetor de IDs, agrupado por avaliador, e os deslocamentos de
+ * cada grupo: os imóveis do avaliador k são imoveis[inicio[k]] até
+ * imoveis[inicio[k + 1] - 1]. São 4 bytes por imóvel mais 4 por avaliador,
+ * sem a folga de crescimento nem o cabeçalho de um vetor por corretor.
+ */
+struct Atribuicao {
+    std::vector<const Corretor*> avaliadores; ///< Avaliadores, em ordem de ID
+    std::vector<std::uint32_t> inicio;        ///< avaliadores.size() + 1 deslocamentos em imoveis
+    std::vector<int> imoveis;                 ///< Posição na base + 1, em ordem crescente de ID dentro de cada grupo (na ordem de visita, se vier de rebalancearRotas)
+
+    int numAvaliadores() const { return static_cast<int>(avaliadores.size()); }
+
+    FaixaImoveis imoveisDe(int k) const {
+        return {imoveis.data() + inicio[k], imoveis.data() + inicio[k + 1]};
+    }
+};
+
+/**
+ * @brief Lista os corretores avaliadores, em ordem de ID, conferindo se há o que agendar
+ * @param corretores Corretores da base
+ * @param imoveis Imóveis da base
+ * @throws std::runtime_error se não houver avaliadores ou imóveis
+ */
+std::vector<const Corretor*> selecionarAvaliadores(const std::vector<Corretor>& corretores,
+                                                   const std::vector<Imovel>& imoveis);
+
+/**
+ * @brief Distribui os imóveis entre os avaliadores segundo o modo escolhido
+ * 
+ * A lista de cada avaliador fica em ordem crescente de ID (o da entrada,
+ * também com a base reordenada pela curva de Hilbert), como na
+ * distribuição Round-Robin, e os dois modos atribuem a mesma quantidade de
+ * imóveis a cada avaliador.
+ * 
+ * @param imoveis Imóveis a distribuir
+ * @param avaliadores Corretores avaliadores, em ordem de ID
+ * @param modo Estratégia de distribuição
+ * @param threads Número de threads para as etapas paralelas
+ */
+Atribuicao atribuirImoveis(const std::vector<Imovel>& imoveis,
+                           const std::vector<const Corretor*>& avaliadores,
+                           ModoAtribuicao modo, int threads);
+
+/**
+ * @brief Distribuição Round-Robin: imóvel i para o avaliador i % k
+ */
+Atribuicao atribuirRoundRobin(const std::vector<Imovel>& imoveis, const std::vector<const Corretor*>& avaliadores);
+
+/**
+ * @brief Faixas do Round-Robin para numImoveis imóveis, ainda sem os IDs
+ *
+ * Como a cota de cada avaliador só depende do total, os imóveis podem ser
+ * posicionados à medida que são lidos (colocarRoundRobin), sem esperar o
+ * fim da entrada.
+ */
+Atribuicao reservarRoundRobin(int numImoveis, const std::vector<const Corretor*>& avaliadores);
+
+/**
+ * @brief Posiciona o imóvel da posição dada (a partir de 0) na faixa do seu avaliador
+ */
+inline void colocarRoundRobin(Atribuicao& atribuicao, int posicao, int imovelId) {
+    int k = atribuicao.numAvaliadores();
+    atribuicao.imoveis[atribuicao.inicio[posicao % k] + posicao / k] = imovelId;
+}
+
+/**
+ * @brief Distribuição por k-means balanceado por capacidade
+ * 
+ * Cada grupo começa na localização de um avaliador e tem capacidade igual à
+ * cota que ele teria no Round-Robin. A cada iteração, os imóveis são
+ * atribuídos em ordem decrescente de "arrependimento" (distância ao segundo
+ * centro mais próximo menos a distância ao primeiro) ao centro livre mais
+ * próximo, e os centros são recalculados. As consultas usam um índice
+ * espacial sobre os centros, então cada iteração custa O(n log n).
+ */
+Atribuicao atribuirCluster(const std::vector<Imovel>& imoveis, const std::vector<const Corretor*>& avaliadores,
+                           int threads);
+
+#endif
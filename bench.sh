@@ -0,0 +1,88 @@
+#!/bin/sh
+# Benchmark por fase (leitura, atribuição, rotas, saída) em várias escalas.
+#
+# Para cada distribuição e cada número de imóveis, gera uma entrada com o
+# gerador sintético, executa o agendamento com --timings e grava uma linha
+# JSON por execução (com o commit atual) no arquivo de resultados. Dois
+# arquivos de commits diferentes podem ser comparados com --comparar.
+#
+# Uso: ./bench.sh [resultados.jsonl]
+#      ./bench.sh --comparar antigo.jsonl novo.jsonl
+#
+# Variáveis de ambiente:
+#   BENCH_TAMANHOS  números de imóveis (padrão: "1000 10000 100000 1000000 10000000")
+#   BENCH_DIST      distribuições (padrão: "uniform clustered city")
+#   BENCH_THREADS   valor de --threads (padrão: 1)
+#   BENCH_ARGS      opções extras para o programa (ex.: "--assign=cluster")
+#   EXE, GERADOR    executáveis (padrão: ./imobiliaria_bench e ./gerador)
+
+if [ "$1" = "--comparar" ]; then
+    [ $# -eq 3 ] || { echo "Uso: $0 --comparar antigo.jsonl novo.jsonl"; exit 1; }
+    # Média de cada fase por (distribuição, imóveis) nos dois arquivos e a razão novo/antigo
+    awk '
+    function campo(linha, nome,    r) {
+        if (match(linha, "\"" nome "\":\"?[^,}\"]*")) {
+            r = substr(linha, RSTART, RLENGTH)
+            sub("^\"" nome "\":\"?", "", r)
+            return r
+        }
+        return ""
+    }
+    {
+        chave = campo($0, "dist") " " campo($0, "imoveis")
+        arquivo = (FILENAME == ARGV[1]) ? 1 : 2
+        n[arquivo, chave]++
+        split("leitura_ms atribuicao_ms rotas_ms saida_ms total_ms", fases, " ")
+        for (f in fases) soma[arquivo, chave, fases[f]] += campo($0, fases[f])
+        if (arquivo == 2 && !(chave in vista)) { vista[chave] = 1; ordem[++total] = chave }
+    }
+    END {
+        printf "%-10s %9s %10s %10s %10s %10s %10s\n", "dist", "imoveis", "leitura", "atribuicao", "rotas", "saida", "total"
+        for (i = 1; i <= total; i++) {
+            chave = ordem[i]
+            if (!((1, chave) in n)) continue
+            split(chave, partes, " ")
+            printf "%-10s %9s", partes[1], partes[2]
+            split("leitura_ms atribuicao_ms rotas_ms saida_ms total_ms", fases, " ")
+            for (f = 1; f <= 5; f++) {
+                antigo = soma[1, chave, fases[f]] / n[1, chave]
+                novo = soma[2, chave, fases[f]] / n[2, chave]
+                if (antigo > 0) printf " %9.2fx", novo / antigo; else printf " %10s", "-"
+            }
+            printf "\n"
+        }
+    }' "$2" "$3"
+    exit 0
+fi
+
+TAMANHOS=${BENCH_TAMANHOS:-"1000 10000 100000 1000000 10000000"}
+DISTRIBUICOES=${BENCH_DIST:-"uniform clustered city"}
+THREADS=${BENCH_THREADS:-1}
+EXE=${EXE:-./imobiliaria_bench}
+GERADOR=${GERADOR:-./gerador}
+COMMIT=$(git rev-parse --short HEAD 2>/dev/null || echo desconhecido)
+git diff --quiet HEAD 2>/dev/null || COMMIT="$COMMIT+"
+RESULTADOS=${1:-bench-$COMMIT.jsonl}
+
+ENTRADA=$(mktemp)
+SAIDA=$(mktemp)
+TEMPOS=$(mktemp)
+trap 'rm -f "$ENTRADA" "$SAIDA" "$TEMPOS"' EXIT
+: > "$RESULTADOS"
+
+printf "%-10s %9s %10s %10s %10s %10s %10s\n" dist imoveis leitura_ms atrib_ms rotas_ms saida_ms total_ms
+for dist in $DISTRIBUICOES; do
+    for n in $TAMANHOS; do
+        "$GERADOR" --imoveis "$n" --dist "$dist" > "$ENTRADA" || exit 1
+        # shellcheck disable=SC2086
+        "$EXE" --timings --threads "$THREADS" $BENCH_ARGS < "$ENTRADA" > "$SAIDA" 2> "$TEMPOS" || { cat "$TEMPOS"; exit 1; }
+        linha=$(grep '^{' "$TEMPOS" | tail -n 1)
+        echo "{\"commit\":\"$COMMIT\",\"dist\":\"$dist\",\"args\":\"$BENCH_ARGS\",${linha#\{}" >> "$RESULTADOS"
+        echo "$linha" | awk -v d="$dist" -v n="$n" '{
+            gsub(/[{}"]/, ""); split($0, pares, ",")
+            for (i in pares) { split(pares[i], kv, ":"); v[kv[1]] = kv[2] }
+            printf "%-10s %9s %10.1f %10.1f %10.1f %10.1f %10.1f\n", d, n, v["leitura_ms"], v["atribuicao_ms"], v["rotas_ms"], v["saida_ms"], v["total_ms"]
+        }'
+    done
+done
+echo "Resultados em $RESULTADOS"
@@ -0,0 +1,53 @@
+#!/bin/sh
+# Benchmark de escalabilidade do modo --threads.
+#
+# Gera uma entrada sintética (corretores e imóveis espalhados numa região
+# de ~35 km), executa o agendamento com 1, 2, 4, ... threads e mostra o
+# tempo e o ganho em relação a 1 thread. Também confere que a saída de cada
+# execução é idêntica à serial.
+#
+# Uso: ./bench_threads.sh [avaliadores] [imoveis] [max_threads]
+
+AVALIADORES=${1:-64}
+IMOVEIS=${2:-400000}
+MAX_THREADS=${3:-$(nproc 2>/dev/null || echo 4)}
+EXE=./imobiliaria
+ENTRADA=$(mktemp)
+SAIDA_SERIAL=$(mktemp)
+SAIDA=$(mktemp)
+trap 'rm -f "$ENTRADA" "$SAIDA_SERIAL" "$SAIDA"' EXIT
+
+awk -v c="$AVALIADORES" -v n="$IMOVEIS" 'BEGIN {
+    srand(42)
+    print c
+    for (i = 1; i <= c; i++)
+        printf "%09d 1 %.5f %.5f Corretor %d\n", i, -3.9 + 0.3 * rand(), -38.7 + 0.3 * rand(), i
+    print ""
+    print 1
+    print "000000000 Cliente Unico"
+    print ""
+    print n
+    for (i = 1; i <= n; i++)
+        printf "Casa 1 %.5f %.5f 100000.0 Rua %d\n", -3.9 + 0.3 * rand(), -38.7 + 0.3 * rand(), i
+}' > "$ENTRADA"
+
+agora() { date +%s.%N; }
+
+echo "avaliadores=$AVALIADORES imoveis=$IMOVEIS"
+printf "%8s %10s %8s\n" threads segundos ganho
+t=1
+base=""
+while [ "$t" -le "$MAX_THREADS" ]; do
+    inicio=$(agora)
+    if [ "$t" -eq 1 ]; then
+        "$EXE" --threads 1 < "$ENTRADA" > "$SAIDA_SERIAL" || exit 1
+    else
+        "$EXE" --threads "$t" < "$ENTRADA" > "$SAIDA" || exit 1
+        cmp -s "$SAIDA" "$SAIDA_SERIAL" || { echo "saída com $t threads difere da serial"; exit 1; }
+    fi
+    fim=$(agora)
+    segundos=$(awk -v a="$inicio" -v b="$fim" 'BEGIN { printf "%.3f", b - a }')
+    [ -z "$base" ] && base=$segundos
+    awk -v t="$t" -v s="$segundos" -v b="$base" 'BEGIN { printf "%8d %10.3f %7.2fx\n", t, s, b / s }'
+    t=$((t * 2))
+done
@@ -0,0 +1,521 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementação da gravação e do carregamento de checkpoints
+ */
+
+#include "checkpoint.h"
+#include "mapeamento.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGICO[8] = {'I', 'M', 'O', 'B', 'C', 'K', 'P', 'T'};
+constexpr std::uint32_t VERSAO_CHECKPOINT = 2;
+constexpr std::uint32_t MARCA_ORDEM_BYTES = 0x01020304;
+
+/**
+ * Cabeçalho fixo de 64 bytes no início do arquivo
+ */
+struct Cabecalho {
+    char magico[8];
+    std::uint32_t versao;
+    std::uint32_t marca;
+    std::uint64_t assinatura;
+    std::uint32_t etapa;
+    std::uint32_t numAvaliadores;
+    std::uint64_t numImoveis;
+    std::uint64_t numRotas;
+    std::uint64_t numVisitas;
+    std::uint64_t tamanhoArquivo;
+};
+static_assert(sizeof(Cabecalho) == 64, "cabeçalho do checkpoint deve ter 64 bytes");
+
+/**
+ * Posição (em bytes desde o início do arquivo) de cada coluna
+ */
+struct Layout {
+    std::uint64_t inicio, imoveis;
+    std::uint64_t rotaIndice, rotaInicio;
+    std::uint64_t visitaImovel, visitaHorario;
+    std::uint64_t soma;
+    std::uint64_t total;
+};
+
+/**
+ * Calcula o layout a partir dos contadores; escrita e leitura usam a mesma função
+ */
+Layout calcularLayout(const Cabecalho& c) {
+    Layout l{};
+    std::uint64_t pos = sizeof(Cabecalho);
+    auto coluna = [&pos](std::uint64_t& campo, std::uint64_t bytes) {
+        campo = pos;
+        pos += (bytes + 7) & ~std::uint64_t(7);
+    };
+    coluna(l.inicio, (std::uint64_t(c.numAvaliadores) + 1) * sizeof(std::uint32_t));
+    coluna(l.imoveis, c.numImoveis * sizeof(std::int32_t));
+    coluna(l.rotaIndice, c.numRotas * sizeof(std::uint32_t));
+    coluna(l.rotaInicio, (c.numRotas + 1) * sizeof(std::uint64_t));
+    coluna(l.visitaImovel, c.numVisitas * sizeof(std::int32_t));
+    coluna(l.visitaHorario, c.numVisitas * sizeof(std::int32_t));
+    coluna(l.soma, sizeof(std::uint64_t));
+    l.total = pos;
+    return l;
+}
+
+/**
+ * Ponteiro tipado para uma coluna do arquivo carregado
+ */
+template <typename T>
+const T* coluna(const char* base, std::uint64_t posicao) {
+    return reinterpret_cast<const T*>(base + posicao);
+}
+
+void invalido(const std::string& motivo) {
+    throw std::runtime_error("Erro: checkpoint inválido: " + motivo);
+}
+
+/**
+ * CRC-32 (polinômio 0xEDB88320, o do zlib) calculado por tabela
+ */
+class Crc32 {
+public:
+    void incluir(const void* dados, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(dados);
+        const std::uint32_t* tabela = tabelaCrc();
+        for (std::size_t i = 0; i < bytes; ++i) {
+            valor = tabela[(valor ^ p[i]) & 0xFF] ^ (valor >> 8);
+        }
+    }
+
+    std::uint32_t resultado() const { return ~valor; }
+
+private:
+    std::uint32_t valor = 0xFFFFFFFFu;
+
+    static const std::uint32_t* tabelaCrc() {
+        static const std::vector<std::uint32_t> tabela = [] {
+            std::vector<std::uint32_t> t(256);
+            for (std::uint32_t n = 0; n < 256; ++n) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[n] = c;
+            }
+            return t;
+        }();
+        return tabela.data();
+    }
+};
+
+/**
+ * FNV-1a aplicado a palavras de 64 bits (basta para distinguir execuções)
+ */
+class Assinatura {
+public:
+    void incluir(std::uint64_t palavra) {
+        valor = (valor ^ palavra) * 0x100000001b3ull;
+    }
+
+    void incluir(double numero) {
+        std::uint64_t palavra;
+        std::memcpy(&palavra, &numero, sizeof(palavra));
+        incluir(palavra);
+    }
+
+    void incluir(const std::string& texto) {
+        incluir(static_cast<std::uint64_t>(texto.size()));
+        for (unsigned char c : texto) {
+            incluir(static_cast<std::uint64_t>(c));
+        }
+    }
+
+    std::uint64_t resultado() const { return valor; }
+
+private:
+    std::uint64_t valor = 0xcbf29ce484222325ull;
+};
+
+/**
+ * Arquivo temporário que só substitui o destino quando está completo no disco
+ */
+class ArquivoTemporario {
+public:
+    explicit ArquivoTemporario(std::string caminho) : caminho(std::move(caminho)) {
+        arquivo = std::fopen(this->caminho.c_str(), "wb");
+        if (!arquivo) {
+            falha("não foi possível criar ");
+        }
+    }
+
+    ~ArquivoTemporario() {
+        if (arquivo) {
+            std::fclose(arquivo);
+            std::remove(caminho.c_str());
+        }
+    }
+
+    ArquivoTemporario(const ArquivoTemporario&) = delete;
+    ArquivoTemporario& operator=(const ArquivoTemporario&) = delete;
+
+    void gravar(const void* dados, std::size_t bytes) {
+        if (bytes > 0 && std::fwrite(dados, 1, bytes, arquivo) != bytes) {
+            falha("falha ao gravar ");
+        }
+        crc.incluir(dados, bytes);
+        posicao += bytes;
+    }
+
+    /// CRC-32 de tudo o que já foi gravado
+    std::uint32_t somaVerificacao() const { return crc.resultado(); }
+
+    /// Completa com zeros até a posição indicada pelo layout
+    void avancarAte(std::uint64_t destino) {
+        static const char zeros[8] = {};
+        gravar(zeros, static_cast<std::size_t>(destino - posicao));
+    }
+
+    /// Grava no disco (fsync) e renomeia sobre o destino
+    void substituir(const std::string& destino) {
+        if (std::fflush(arquivo) != 0 || ::fsync(fileno(arquivo)) != 0) {
+            falha("falha ao gravar ");
+        }
+        int resultado = std::fclose(arquivo);
+        arquivo = nullptr;
+        if (resultado != 0 || std::rename(caminho.c_str(), destino.c_str()) != 0) {
+            std::string motivo = std::strerror(errno);
+            std::remove(caminho.c_str());
+            throw std::runtime_error("Erro: falha ao gravar " + destino + ": " + motivo);
+        }
+    }
+
+private:
+    std::string caminho;
+    std::FILE* arquivo = nullptr;
+    std::uint64_t posicao = 0;
+    Crc32 crc;
+
+    [[noreturn]] void falha(const char* acao) {
+        throw std::runtime_error("Erro: " + std::string(acao) + caminho + ": " + std::strerror(errno));
+    }
+};
+
+template <typename T>
+void gravarColuna(ArquivoTemporario& arquivo, std::uint64_t posicao, const std::vector<T>& valores) {
+    arquivo.avancarAte(posicao);
+    arquivo.gravar(valores.data(), valores.size() * sizeof(T));
+}
+
+} // namespace
+
+/**
+ * @brief Grava de uma vez um checkpoint com as rotas prontas indicadas
+ *
+ * A soma de verificação é acumulada enquanto o arquivo é gravado e fecha o
+ * arquivo.
+ */
+void gravarCheckpoint(const std::string& caminho, std::uint64_t assinatura, int etapa,
+                      const Atribuicao& atribuicao, const std::vector<std::vector<Agendamento>>& agendas,
+                      const std::vector<std::uint32_t>& rotas) {
+    std::vector<std::uint64_t> rotaInicio{0};
+    for (std::uint32_t r : rotas) {
+        rotaInicio.push_back(rotaInicio.back() + agendas[r].size());
+    }
+
+    Cabecalho cabecalho{};
+    std::memcpy(cabecalho.magico, MAGICO, sizeof(MAGICO));
+    cabecalho.versao = VERSAO_CHECKPOINT;
+    cabecalho.marca = MARCA_ORDEM_BYTES;
+    cabecalho.assinatura = assinatura;
+    cabecalho.etapa = static_cast<std::uint32_t>(etapa);
+    cabecalho.numAvaliadores = static_cast<std::uint32_t>(atribuicao.numAvaliadores());
+    cabecalho.numImoveis = atribuicao.imoveis.size();
+    cabecalho.numRotas = rotas.size();
+    cabecalho.numVisitas = rotaInicio.back();
+    Layout layout = calcularLayout(cabecalho);
+    cabecalho.tamanhoArquivo = layout.total;
+
+    ArquivoTemporario arquivo(caminho + ".tmp");
+    arquivo.gravar(&cabecalho, sizeof(cabecalho));
+    gravarColuna(arquivo, layout.inicio, atribuicao.inicio);
+    gravarColuna(arquivo, layout.imoveis, atribuicao.imoveis);
+    gravarColuna(arquivo, layout.rotaIndice, rotas);
+    gravarColuna(arquivo, layout.rotaInicio, rotaInicio);
+
+    // As visitas saem rota a rota, sem montar as colunas inteiras em memória
+    std::vector<std::int32_t> valores;
+    arquivo.avancarAte(layout.visitaImovel);
+    for (std::uint32_t r : rotas) {
+        valores.clear();
+        for (const Agendamento& visita : agendas[r]) {
+            valores.push_back(visita.imovelId);
+        }
+        arquivo.gravar(valores.data(), valores.size() * sizeof(std::int32_t));
+    }
+    arquivo.avancarAte(layout.visitaHorario);
+    for (std::uint32_t r : rotas) {
+        valores.clear();
+        for (const Agendamento& visita : agendas[r]) {
+            valores.push_back(visita.hora * 60 + visita.minuto);
+        }
+        arquivo.gravar(valores.data(), valores.size() * sizeof(std::int32_t));
+    }
+    arquivo.avancarAte(layout.soma);
+    std::uint64_t soma = arquivo.somaVerificacao();
+    arquivo.gravar(&soma, sizeof(soma));
+    arquivo.substituir(caminho);
+}
+
+/**
+ * @brief Assinatura da base e das opções que determinam as rotas
+ *
+ * Threads não entram (a saída não depende delas), exceto no número de buscas
+ * do rebalanceamento, que por padrão é uma por thread.
+ */
+std::uint64_t assinaturaExecucao(const std::vector<Corretor>& corretores,
+                                 const std::vector<Imovel>& imoveis,
+                                 const Opcoes& opcoes) {
+    Assinatura assinatura;
+    assinatura.incluir(static_cast<std::uint64_t>(VERSAO_CHECKPOINT));
+    assinatura.incluir(static_cast<std::uint64_t>(corretores.size()));
+    for (const Corretor& corretor : corretores) {
+        assinatura.incluir(corretor.latitude);
+        assinatura.incluir(corretor.longitude);
+        assinatura.incluir(static_cast<std::uint64_t>(corretor.isAvaliador()));
+    }
+    assinatura.incluir(static_cast<std::uint64_t>(imoveis.size()));
+    for (const Imovel& imovel : imoveis) {
+        assinatura.incluir(imovel.latitude);
+        assinatura.incluir(imovel.longitude);
+        assinatura.incluir(static_cast<std::uint64_t>(imovel.tipo) << 32 | static_cast<std::uint32_t>(imovel.id));
+    }
+
+    const ConfiguracaoRota& rota = opcoes.rota;
+    assinatura.incluir(static_cast<std::uint64_t>(opcoes.atribuicao));
+    assinatura.incluir(static_cast<std::uint64_t>(opcoes.reordenarBase));
+    assinatura.incluir(static_cast<std::uint64_t>(rota.heuristica));
+    assinatura.incluir(static_cast<std::uint64_t>(rota.melhoriaMs));
+    assinatura.incluir(static_cast<std::uint64_t>(rota.distancia));
+    assinatura.incluir(opcoes.arquivoRede);
+    assinatura.incluir(static_cast<std::uint64_t>(rota.tempo));
+    assinatura.incluir(static_cast<std::uint64_t>(rota.exatoAte));
+    assinatura.incluir(rota.raioParadasM);
+
+    const ConfiguracaoRebalanceamento& rebalanceamento = opcoes.rebalanceamento;
+    assinatura.incluir(static_cast<std::uint64_t>(rebalanceamento.limiteMs));
+    if (rebalanceamento.limiteMs > 0) {
+        assinatura.incluir(static_cast<std::uint64_t>(rebalanceamento.rodadas));
+        assinatura.incluir(static_cast<std::uint64_t>(rebalanceamento.buscas > 0 ? rebalanceamento.buscas
+                                                                                  : opcoes.threads));
+        assinatura.incluir(rebalanceamento.semente);
+    }
+    return assinatura.resultado();
+}
+
+/**
+ * @brief Carrega um checkpoint gravado por GravadorCheckpoint
+ *
+ * Confere cabeçalho, tamanho, soma de verificação, assinatura e todas as referências (faixas da
+ * atribuição, índices das rotas, IDs e quantidade de visitas) antes de
+ * devolver o estado.
+ */
+bool carregarCheckpoint(const std::string& caminho, std::uint64_t assinatura,
+                        const std::vector<const Corretor*>& avaliadores, int numImoveis,
+                        EstadoCheckpoint& estado) {
+    if (::access(caminho.c_str(), F_OK) != 0) {
+        return false;
+    }
+    ArquivoMapeado arquivo(caminho);
+    const char* base = arquivo.dados();
+
+    if (arquivo.tamanho() < sizeof(Cabecalho)) {
+        invalido("arquivo muito pequeno");
+    }
+    Cabecalho cabecalho;
+    std::memcpy(&cabecalho, base, sizeof(cabecalho));
+    if (std::memcmp(cabecalho.magico, MAGICO, sizeof(MAGICO)) != 0) {
+        invalido("assinatura desconhecida");
+    }
+    if (cabecalho.marca != MARCA_ORDEM_BYTES) {
+        invalido("ordem de bytes diferente da máquina");
+    }
+    if (cabecalho.versao != VERSAO_CHECKPOINT) {
+        invalido("versão " + std::to_string(cabecalho.versao) + " não suportada");
+    }
+    if (cabecalho.numImoveis > arquivo.tamanho() || cabecalho.numRotas > arquivo.tamanho() ||
+        cabecalho.numVisitas > arquivo.tamanho()) {
+        invalido("tamanho não confere com o cabeçalho");
+    }
+    Layout layout = calcularLayout(cabecalho);
+    if (cabecalho.tamanhoArquivo != arquivo.tamanho() || layout.total != arquivo.tamanho()) {
+        invalido("tamanho não confere com o cabeçalho");
+    }
+    Crc32 crc;
+    crc.incluir(base, static_cast<std::size_t>(layout.soma));
+    if (*coluna<std::uint64_t>(base, layout.soma) != crc.resultado()) {
+        invalido("soma de verificação não confere");
+    }
+    if (cabecalho.assinatura != assinatura) {
+        throw std::runtime_error("Erro: o checkpoint " + caminho + " foi gravado com outra base ou outras opções");
+    }
+    if (cabecalho.etapa != EtapaRotas && cabecalho.etapa != EtapaRebalanceadas) {
+        invalido("etapa desconhecida");
+    }
+    if (cabecalho.numAvaliadores != avaliadores.size() || cabecalho.numImoveis != static_cast<std::uint64_t>(numImoveis)) {
+        invalido("atribuição não confere com a base");
+    }
+
+    // Atribuição: faixas crescentes que cobrem todos os imóveis
+    const std::uint32_t* inicio = coluna<std::uint32_t>(base, layout.inicio);
+    const std::int32_t* imoveis = coluna<std::int32_t>(base, layout.imoveis);
+    Atribuicao& atribuicao = estado.atribuicao;
+    atribuicao.avaliadores = avaliadores;
+    atribuicao.inicio.assign(inicio, inicio + cabecalho.numAvaliadores + 1);
+    atribuicao.imoveis.assign(imoveis, imoveis + cabecalho.numImoveis);
+    if (atribuicao.inicio.front() != 0 || atribuicao.inicio.back() != cabecalho.numImoveis) {
+        invalido("faixas da atribuição corrompidas");
+    }
+    std::vector<int> tamanhoRota;
+    for (int k = 0; k < atribuicao.numAvaliadores(); ++k) {
+        if (atribuicao.inicio[k] > atribuicao.inicio[k + 1]) {
+            invalido("faixas da atribuição corrompidas");
+        }
+        if (!atribuicao.imoveisDe(k).vazia()) {
+            tamanhoRota.push_back(static_cast<int>(atribuicao.imoveisDe(k).tamanho()));
+        }
+    }
+    for (int id : atribuicao.imoveis) {
+        if (id <= 0 || id > numImoveis) {
+            invalido("ID de imóvel fora do intervalo");
+        }
+    }
+
+    // Rotas prontas, em ordem crescente de índice, com uma visita por imóvel
+    const std::uint32_t* rotaIndice = coluna<std::uint32_t>(base, layout.rotaIndice);
+    const std::uint64_t* rotaInicio = coluna<std::uint64_t>(base, layout.rotaInicio);
+    const std::int32_t* visitaImovel = coluna<std::int32_t>(base, layout.visitaImovel);
+    const std::int32_t* visitaHorario = coluna<std::int32_t>(base, layout.visitaHorario);
+    if (rotaInicio[0] != 0 || rotaInicio[cabecalho.numRotas] != cabecalho.numVisitas) {
+        invalido("rotas corrompidas");
+    }
+    estado.etapa = static_cast<int>(cabecalho.etapa);
+    estado.prontas.assign(tamanhoRota.size(), 0);
+    estado.agendas.assign(tamanhoRota.size(), {});
+    for (std::uint64_t r = 0; r < cabecalho.numRotas; ++r) {
+        std::uint32_t i = rotaIndice[r];
+        if (i >= tamanhoRota.size() || (r > 0 && i <= rotaIndice[r - 1]) || rotaInicio[r] > rotaInicio[r + 1] ||
+            rotaInicio[r + 1] - rotaInicio[r] != static_cast<std::uint64_t>(tamanhoRota[i])) {
+            invalido("rotas corrompidas");
+        }
+        std::vector<Agendamento>& agenda = estado.agendas[i];
+        agenda.reserve(tamanhoRota[i]);
+        for (std::uint64_t v = rotaInicio[r]; v < rotaInicio[r + 1]; ++v) {
+            if (visitaImovel[v] <= 0 || visitaImovel[v] > numImoveis || visitaHorario[v] < 0) {
+                invalido("visita corrompida");
+            }
+            agenda.emplace_back(visitaHorario[v] / 60, visitaHorario[v] % 60, visitaImovel[v]);
+        }
+        estado.prontas[i] = 1;
+    }
+    return true;
+}
+
+GravadorCheckpoint::GravadorCheckpoint(std::string caminho, std::uint64_t assinatura, int intervaloMs)
+    : caminho(std::move(caminho)), assinatura(assinatura), intervalo(intervaloMs) {
+    thread = std::thread(&GravadorCheckpoint::executar, this);
+}
+
+GravadorCheckpoint::~GravadorCheckpoint() {
+    parar();
+}
+
+void GravadorCheckpoint::iniciarEtapa(int etapa, const Atribuicao& atribuicao,
+                                      const std::vector<std::vector<Agendamento>>& agendas,
+                                      std::vector<std::uint8_t> prontas) {
+    std::unique_lock<std::mutex> trava(mutex);
+    sinal.wait(trava, [this] { return !gravando; });
+    this->etapa = etapa;
+    this->atribuicao = &atribuicao;
+    this->agendas = &agendas;
+    this->prontas = std::move(prontas);
+    urgente = true;
+    sinal.notify_all();
+}
+
+void GravadorCheckpoint::rotaPronta(int i) {
+    std::lock_guard<std::mutex> trava(mutex);
+    prontas[i] = 1;
+    pendente = true;
+}
+
+void GravadorCheckpoint::encerrarEtapa() {
+    std::unique_lock<std::mutex> trava(mutex);
+    sinal.wait(trava, [this] { return !gravando; });
+    atribuicao = nullptr;
+    agendas = nullptr;
+    prontas.clear();
+    pendente = false;
+    urgente = false;
+}
+
+void GravadorCheckpoint::concluir() {
+    parar();
+    std::remove(caminho.c_str());
+}
+
+void GravadorCheckpoint::parar() {
+    {
+        std::lock_guard<std::mutex> trava(mutex);
+        encerrar = true;
+    }
+    sinal.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+/**
+ * Laço da thread: grava no início de cada etapa e, depois, a cada intervalo
+ * com rotas novas. A lista de rotas prontas é copiada sob o mutex; as
+ * agendas dessas rotas não mudam mais, então são lidas sem ele.
+ */
+void GravadorCheckpoint::executar() {
+    std::unique_lock<std::mutex> trava(mutex);
+    auto proxima = std::chrono::steady_clock::now() + intervalo;
+    while (true) {
+        sinal.wait_until(trava, proxima, [this] { return encerrar || urgente; });
+        if (encerrar) {
+            return;
+        }
+        proxima = std::chrono::steady_clock::now() + intervalo;
+        if (atribuicao == nullptr || !(urgente || pendente)) {
+            continue;
+        }
+        urgente = false;
+        pendente = false;
+        gravando = true;
+        std::vector<std::uint32_t> rotas;
+        for (std::size_t i = 0; i < prontas.size(); ++i) {
+            if (prontas[i]) {
+                rotas.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        int etapaAtual = etapa;
+        const Atribuicao& atribuicaoAtual = *atribuicao;
+        const std::vector<std::vector<Agendamento>>& agendasAtuais = *agendas;
+        trava.unlock();
+        try {
+            gravarCheckpoint(caminho, assinatura, etapaAtual, atribuicaoAtual, agendasAtuais, rotas);
+        } catch (const std::exception& e) {
+            std::cerr << "Checkpoint não gravado: " << e.what() << std::endl;
+        }
+        trava.lock();
+        gravando = false;
+        sinal.notify_all();
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file checkpoint.h
+ * @brief Checkpoint da execução em fases e retomada (--checkpoint ARQ, --resume)
+ *
+ * Durante a geração das rotas, uma thread grava periodicamente num arquivo
+ * a atribuição e as agendas já prontas. Se o processo for interrompido, uma
+ * nova execução com --resume carrega o arquivo, pula a atribuição e as rotas
+ * gravadas e calcula só as que faltam. Cada rota depende apenas da
+ * atribuição e das opções, então a saída é idêntica à de uma execução sem
+ * interrupção (desde que nenhuma etapa tenha limite de tempo, como
+ * --improve-ms ou --rebalance-ms).
+ *
+ * O arquivo é sempre reescrito inteiro num temporário (ARQ.tmp), sincronizado
+ * com fsync e renomeado sobre ARQ: uma interrupção no meio da gravação deixa
+ * o checkpoint anterior intacto. Ao fim da execução, o arquivo é apagado.
+ *
+ * Layout (versão 2, ordem de bytes da máquina, verificada pelo campo marca):
+ *   - Cabeçalho de 64 bytes: "IMOBCKPT", versão, marca 0x01020304,
+ *     assinatura da execução, etapa, número de avaliadores, de imóveis
+ *     atribuídos, de rotas prontas e de visitas, e tamanho total.
+ *   - Colunas alinhadas em 8 bytes:
+ *       atribuição:    inicio u32[avaliadores + 1], imoveis i32[imóveis]
+ *       rotas prontas: índice u32[rotas], início u64[rotas + 1]
+ *       visitas:       imóvel i32[visitas], horário i32[visitas] (hora * 60 + minuto)
+ *       soma:          u64 com o CRC-32 de todos os bytes anteriores
+ *
+ * Um arquivo cuja soma não confere é recusado, em vez de retomar rotas ou
+ * uma atribuição corrompidas.
+ *
+ * A assinatura (FNV-1a sobre palavras de 64 bits) cobre coordenadas e tipos
+ * dos imóveis, os corretores e as opções que mudam as rotas; um checkpoint
+ * de outra base ou de outras opções é recusado.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "agendamento.h"
+#include "atribuicao.h"
+#include "corretor.h"
+#include "imovel.h"
+#include "opcoes.h"
+
+/// Etapa da execução em que o checkpoint foi gravado
+enum EtapaCheckpoint {
+    EtapaRotas = 0,          ///< Primeira geração das rotas
+    EtapaRebalanceadas = 1   ///< Rotas na ordem do rebalanceamento (--rebalance-ms)
+};
+
+/**
+ * @struct EstadoCheckpoint
+ * @brief Conteúdo de um checkpoint carregado
+ */
+struct EstadoCheckpoint {
+    int etapa = EtapaRotas;
+    Atribuicao atribuicao; ///< Com os avaliadores da base atual
+    std::vector<std::uint8_t> prontas;              ///< Uma por avaliador com imóveis, em ordem de ID: 1 se a rota foi gravada
+    std::vector<std::vector<Agendamento>> agendas;  ///< Agenda de cada rota pronta (vazia nas demais)
+};
+
+/**
+ * @brief Assinatura da base e das opções que determinam as rotas
+ * @param corretores Corretores da base
+ * @param imoveis Imóveis da base (na ordem usada pela execução)
+ * @param opcoes Opções da execução
+ */
+std::uint64_t assinaturaExecucao(const std::vector<Corretor>& corretores,
+                                 const std::vector<Imovel>& imoveis,
+                                 const Opcoes& opcoes);
+
+/**
+ * @brief Grava de uma vez um checkpoint (GravadorCheckpoint usa esta função)
+ * @param caminho Arquivo do checkpoint (substituído só com a gravação completa)
+ * @param assinatura Assinatura da execução (ver assinaturaExecucao)
+ * @param etapa Etapa (EtapaCheckpoint)
+ * @param atribuicao Atribuição da etapa
+ * @param agendas Agendas dos avaliadores com imóveis, em ordem de ID
+ * @param rotas Índices, em ordem crescente, das agendas prontas a gravar
+ * @throws std::runtime_error se o arquivo não puder ser gravado
+ */
+void gravarCheckpoint(const std::string& caminho, std::uint64_t assinatura, int etapa,
+                      const Atribuicao& atribuicao, const std::vector<std::vector<Agendamento>>& agendas,
+                      const std::vector<std::uint32_t>& rotas);
+
+/**
+ * @brief Carrega um checkpoint gravado por GravadorCheckpoint
+ * @param caminho Arquivo do checkpoint
+ * @param assinatura Assinatura da execução atual (ver assinaturaExecucao)
+ * @param avaliadores Avaliadores da base, em ordem de ID
+ * @param numImoveis Número de imóveis da base
+ * @param estado Recebe o conteúdo do checkpoint
+ * @return false se o arquivo não existir (nada a retomar)
+ * @throws std::runtime_error se o arquivo estiver corrompido (inclusive pela soma de verificação) ou for de
+ *         outra base ou de outras opções
+ */
+bool carregarCheckpoint(const std::string& caminho, std::uint64_t assinatura,
+                        const std::vector<const Corretor*>& avaliadores, int numImoveis,
+                        EstadoCheckpoint& estado);
+
+/**
+ * @class GravadorCheckpoint
+ * @brief Thread que grava o checkpoint a cada intervalo enquanto as rotas são geradas
+ *
+ * A cada etapa, quem gera as rotas informa a atribuição e o vetor de agendas
+ * (iniciarEtapa), avisa cada rota concluída (rotaPronta, de qualquer thread)
+ * e, antes de alterar a atribuição ou as agendas, encerra a etapa
+ * (encerrarEtapa). O início de uma etapa é gravado logo; depois, o arquivo
+ * só é regravado a cada intervalo se alguma rota ficou pronta. Falhas de
+ * gravação são informadas na saída de erro sem interromper a execução.
+ */
+class GravadorCheckpoint {
+public:
+    /**
+     * @param caminho Arquivo do checkpoint
+     * @param assinatura Assinatura da execução (ver assinaturaExecucao)
+     * @param intervaloMs Intervalo mínimo entre gravações
+     */
+    GravadorCheckpoint(std::string caminho, std::uint64_t assinatura, int intervaloMs);
+
+    /// Para a thread, sem gravar o que estiver pendente
+    ~GravadorCheckpoint();
+
+    GravadorCheckpoint(const GravadorCheckpoint&) = delete;
+    GravadorCheckpoint& operator=(const GravadorCheckpoint&) = delete;
+
+    /**
+     * @brief Começa uma etapa; atribuição e agendas não podem mudar até encerrarEtapa
+     * @param etapa Etapa (EtapaCheckpoint)
+     * @param atribuicao Atribuição da etapa
+     * @param agendas Agendas dos avaliadores com imóveis, em ordem de ID
+     * @param prontas Rotas que já começam prontas (retomadas de outro checkpoint)
+     */
+    void iniciarEtapa(int etapa, const Atribuicao& atribuicao,
+                      const std::vector<std::vector<Agendamento>>& agendas,
+                      std::vector<std::uint8_t> prontas);
+
+    /// Marca a agenda da rota i como concluída (ela não muda mais na etapa)
+    void rotaPronta(int i);
+
+    /// Espera a gravação em andamento e solta a atribuição e as agendas
+    void encerrarEtapa();
+
+    /// Para a thread e apaga o checkpoint (execução concluída)
+    void concluir();
+
+private:
+    void executar();
+    void parar();
+
+    std::string caminho;
+    std::uint64_t assinatura;
+    std::chrono::milliseconds intervalo;
+
+    std::mutex mutex;
+    std::condition_variable sinal;
+    bool encerrar = false;  ///< A thread deve terminar
+    bool pendente = false;  ///< Há rotas prontas ainda não gravadas
+    bool urgente = false;   ///< Gravar sem esperar o intervalo (início de etapa)
+    bool gravando = false;  ///< A thread está lendo a atribuição e as agendas
+    int etapa = EtapaRotas;
+    const Atribuicao* atribuicao = nullptr;
+    const std::vector<std::vector<Agendamento>>* agendas = nullptr;
+    std::vector<std::uint8_t> prontas;
+    std::thread thread;
+};
+
+#endif
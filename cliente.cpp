@@ -8,18 +8,15 @@
 
 #include "cliente.h"
 
-// Inicialização do contador estático de IDs
-int Cliente::nextId = 1;
-
 /**
  * @brief Construtor da classe Cliente
  * 
- * Inicializa um novo cliente com as informações fornecidas e
- * atribui automaticamente um ID único sequencial.
+ * Inicializa um novo cliente com as informações fornecidas.
  * 
+ * @param id ID do cliente
  * @param telefone Número de telefone do cliente
  * @param nome Nome completo do cliente
  */
-Cliente::Cliente(const std::string& telefone, const std::string& nome)
-    : id(nextId++), telefone(telefone), nome(nome) {
+Cliente::Cliente(int id, std::string_view telefone, std::string_view nome)
+    : telefone(telefone), nome(nome), id(id) {
 } 
\ No newline at end of file
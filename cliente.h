@@ -10,6 +10,7 @@
 #define CLIENTE_H
 
 #include <string>
+#include <string_view>
 
 /**
  * @class Cliente
@@ -18,22 +19,23 @@
  * Um cliente possui informações básicas como nome e telefone.
  * Clientes podem ser proprietários de imóveis que serão avaliados
  * pelos corretores avaliadores.
+ * 
+ * Nome e telefone são views de textos guardados numa ArenaTextos
+ * (textos.h), que precisa durar tanto quanto o cliente.
  */
 class Cliente {
-private:
-    static int nextId; ///< Contador estático para gerar IDs únicos
-    
 public:
-    int id;              ///< ID único do cliente (auto-incremento)
-    std::string telefone; ///< Número de telefone do cliente
-    std::string nome;     ///< Nome completo do cliente
+    std::string_view telefone; ///< Número de telefone do cliente
+    std::string_view nome;     ///< Nome completo do cliente
+    int id;                    ///< ID do cliente (posição na base, a partir de 1)
     
     /**
      * @brief Construtor da classe Cliente
+     * @param id ID do cliente (quem lê a base numera 1, 2, ...)
      * @param telefone Número de telefone do cliente
      * @param nome Nome completo do cliente
      */
-    Cliente(const std::string& telefone, const std::string& nome);
+    Cliente(int id, std::string_view telefone, std::string_view nome);
 };
 
 #endif 
\ No newline at end of file
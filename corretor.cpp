@@ -8,23 +8,20 @@
 
 #include "corretor.h"
 
-// Inicialização do contador estático de IDs
-int Corretor::nextId = 1;
-
 /**
  * @brief Construtor da classe Corretor
  * 
- * Inicializa um novo corretor com as informações fornecidas e
- * atribui automaticamente um ID único sequencial.
+ * Inicializa um novo corretor com as informações fornecidas.
  * 
+ * @param id ID do corretor
  * @param telefone Número de telefone do corretor
  * @param avaliador Indica se o corretor é um avaliador (true) ou não (false)
  * @param lat Latitude da localização do corretor
  * @param lon Longitude da localização do corretor
  * @param nome Nome completo do corretor
  */
-Corretor::Corretor(const std::string& telefone, bool avaliador, double lat, double lon, const std::string& nome)
-    : id(nextId++), telefone(telefone), avaliador(avaliador), latitude(lat), longitude(lon), nome(nome) {
+Corretor::Corretor(int id, std::string_view telefone, bool avaliador, double lat, double lon, std::string_view nome)
+    : latitude(lat), longitude(lon), telefone(telefone), nome(nome), id(id), avaliador(avaliador) {
 }
 
 /**
@@ -35,15 +32,3 @@ Corretor::Corretor(const std::string& telefone, bool avaliador, double lat, doub
 bool Corretor::isAvaliador() const {
     return avaliador;
 }
-
-/**
- * @brief Adiciona um imóvel à lista de imóveis atribuídos ao corretor
- * 
- * Este método é usado durante a distribuição Round-Robin dos imóveis
- * entre os corretores avaliadores.
- * 
- * @param imovelId ID do imóvel a ser adicionado à lista do corretor
- */
-void Corretor::adicionarImovel(int imovelId) {
-    imoveisAtribuidos.push_back(imovelId);
-} 
\ No newline at end of file
@@ -10,7 +10,7 @@
 #define CORRETOR_H
 
 #include <string>
-#include <vector>
+#include <string_view>
 
 /**
  * @class Corretor
@@ -18,42 +18,38 @@
  * 
  * Um corretor possui informações pessoais, localização geográfica e pode
  * ser ou não um avaliador. Corretores avaliadores recebem imóveis para
- * avaliar através do algoritmo de distribuição Round-Robin.
+ * avaliar através do algoritmo de distribuição Round-Robin; a lista de cada
+ * um fica fora do corretor, num único vetor para todos (Atribuicao, em
+ * atribuicao.h).
+ * 
+ * Nome e telefone são views de textos guardados numa ArenaTextos
+ * (textos.h), que precisa durar tanto quanto o corretor.
  */
 class Corretor {
-private:
-    static int nextId; ///< Contador estático para gerar IDs únicos
-    
 public:
-    int id;                           ///< ID único do corretor (auto-incremento)
-    std::string telefone;             ///< Número de telefone do corretor
-    bool avaliador;                   ///< Indica se o corretor é um avaliador
     double latitude;                  ///< Latitude da localização do corretor
     double longitude;                 ///< Longitude da localização do corretor
-    std::string nome;                 ///< Nome completo do corretor
-    std::vector<int> imoveisAtribuidos; ///< IDs dos imóveis atribuídos a este corretor
+    std::string_view telefone;        ///< Número de telefone do corretor
+    std::string_view nome;            ///< Nome completo do corretor
+    int id;                           ///< ID do corretor (posição na base, a partir de 1)
+    bool avaliador;                   ///< Indica se o corretor é um avaliador
     
     /**
      * @brief Construtor da classe Corretor
+     * @param id ID do corretor (quem lê a base numera 1, 2, ...)
      * @param telefone Número de telefone do corretor
      * @param avaliador Indica se o corretor é um avaliador
      * @param lat Latitude da localização
      * @param lon Longitude da localização
      * @param nome Nome completo do corretor
      */
-    Corretor(const std::string& telefone, bool avaliador, double lat, double lon, const std::string& nome);
+    Corretor(int id, std::string_view telefone, bool avaliador, double lat, double lon, std::string_view nome);
     
     /**
      * @brief Verifica se o corretor é um avaliador
      * @return true se for avaliador, false caso contrário
      */
     bool isAvaliador() const;
-    
-    /**
-     * @brief Adiciona um imóvel à lista de imóveis atribuídos ao corretor
-     * @param imovelId ID do imóvel a ser adicionado
-     */
-    void adicionarImovel(int imovelId);
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * @file curva.cpp
+ * @brief Implementação da curva de Hilbert e da reordenação da base
+ */
+
+#include "curva.h"
+#include <cmath>
+
+/**
+ * @brief Posição da célula ao longo da curva (conversão xy -> d clássica)
+ *
+ * A cada nível, o quadrante da célula dá dois bits da posição; o quadrado
+ * é então girado ou espelhado para que o próximo nível seja percorrido na
+ * orientação do quadrante.
+ */
+std::uint32_t indiceHilbert(std::uint32_t x, std::uint32_t y) {
+    const std::uint32_t lado = 1u << NIVEIS_CURVA;
+    std::uint32_t d = 0;
+    for (std::uint32_t s = lado / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = lado - 1 - x;
+                y = lado - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+void GradeCurva::incluir(double lat, double lon) {
+    if (vazia) {
+        latMin = latMax = lat;
+        lonMin = lonMax = lon;
+        vazia = false;
+        return;
+    }
+    latMin = std::min(latMin, lat);
+    latMax = std::max(latMax, lat);
+    lonMin = std::min(lonMin, lon);
+    lonMax = std::max(lonMax, lon);
+}
+
+std::uint32_t GradeCurva::indice(double lat, double lon) const {
+    const double ultima = static_cast<double>((1u << NIVEIS_CURVA) - 1);
+    double extensao = std::max(latMax - latMin, lonMax - lonMin);
+    double escala = extensao > 0.0 ? ultima / extensao : 0.0;
+    auto celula = [&](double valor) {
+        return static_cast<std::uint32_t>(std::min(ultima, std::max(0.0, std::floor(valor * escala))));
+    };
+    return indiceHilbert(celula(lon - lonMin), celula(lat - latMin));
+}
+
+/**
+ * @brief Coloca os imóveis em ordem da curva de Hilbert
+ */
+void reordenarPelaCurva(std::vector<Imovel>& imoveis) {
+    int n = static_cast<int>(imoveis.size());
+    GradeCurva grade;
+    for (const Imovel& imovel : imoveis) {
+        grade.incluir(imovel.latitude, imovel.longitude);
+    }
+    std::vector<std::pair<std::uint32_t, int>> chaves(n);
+    for (int p = 0; p < n; ++p) {
+        chaves[p] = {grade.indice(imoveis[p].latitude, imoveis[p].longitude), p};
+    }
+    std::sort(chaves.begin(), chaves.end());
+
+    // origem[p]: posição atual do imóvel que deve ir para p; vira p quando ele chega
+    std::vector<int> origem(n);
+    for (int p = 0; p < n; ++p) {
+        origem[p] = chaves[p].second;
+    }
+    chaves = {};
+    for (int inicio = 0; inicio < n; ++inicio) {
+        if (origem[inicio] == inicio) {
+            continue;
+        }
+        Imovel guardado = imoveis[inicio];
+        int p = inicio;
+        while (origem[p] != inicio) {
+            imoveis[p] = imoveis[origem[p]];
+            int proxima = origem[p];
+            origem[p] = p;
+            p = proxima;
+        }
+        imoveis[p] = guardado;
+        origem[p] = p;
+    }
+}
+
+/**
+ * @brief Indica se algum imóvel não está na posição do seu ID
+ */
+bool baseReordenada(const std::vector<Imovel>& imoveis) {
+    for (std::size_t p = 0; p < imoveis.size(); ++p) {
+        if (imoveis[p].id != static_cast<int>(p) + 1) {
+            return true;
+        }
+    }
+    return false;
+}
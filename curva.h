@@ -0,0 +1,130 @@
+/**
+ * @file curva.h
+ * @brief Curva de Hilbert: ordem espacial dos imóveis e rota pela curva
+ *
+ * A curva de Hilbert percorre uma grade de 2^NIVEIS_CURVA x 2^NIVEIS_CURVA
+ * células passando uma única vez por cada uma, sempre entre células
+ * vizinhas; pontos próximos no plano tendem a ficar próximos na ordem da
+ * curva. Ela é usada de duas formas:
+ *   - reordenarPelaCurva (--reorder=hilbert): coloca a base em ordem da
+ *     curva logo após a leitura, para que os imóveis de uma mesma região
+ *     fiquem juntos na memória. O ID de cada imóvel (Imovel::id) continua
+ *     sendo o da entrada; o resto do programa passa a usar a posição + 1, e
+ *     a saída volta ao ID da entrada pela tabela guardada nos próprios
+ *     imóveis;
+ *   - rotaCurva (--route=sfc): a ordem de visita é a ordem da curva, em
+ *     O(n log n), para corretores com tantos imóveis que até o vizinho mais
+ *     próximo com índice espacial fica lento.
+ *
+ * A grade cobre a caixa dos pontos com a mesma escala nos dois eixos (em
+ * graus); pontos na mesma célula ficam na ordem em que estavam.
+ */
+
+#ifndef CURVA_H
+#define CURVA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "coordenadas.h"
+#include "imovel.h"
+
+/// Níveis da curva: 65.536 células por eixo (menos de 1 m numa cidade de 50 km)
+constexpr int NIVEIS_CURVA = 16;
+
+/**
+ * @brief Posição da célula (x, y) ao longo da curva de Hilbert
+ * @param x Coluna, de 0 a 2^NIVEIS_CURVA - 1
+ * @param y Linha, de 0 a 2^NIVEIS_CURVA - 1
+ */
+std::uint32_t indiceHilbert(std::uint32_t x, std::uint32_t y);
+
+/**
+ * @class GradeCurva
+ * @brief Grade da curva sobre a caixa de um conjunto de pontos
+ */
+class GradeCurva {
+public:
+    /// Amplia a caixa para conter o ponto
+    void incluir(double lat, double lon);
+
+    /// Posição do ponto na curva (pontos fora da caixa vão para a borda)
+    std::uint32_t indice(double lat, double lon) const;
+
+private:
+    double latMin = 0.0;
+    double latMax = 0.0;
+    double lonMin = 0.0;
+    double lonMax = 0.0;
+    bool vazia = true;
+};
+
+/**
+ * @brief Coloca os imóveis em ordem da curva de Hilbert
+ *
+ * A permutação é feita no próprio vetor, seguindo os ciclos, sem uma
+ * segunda cópia da base. Imovel::id não muda: depois da chamada, o imóvel
+ * da posição p tem o ID da entrada imoveis[p].id, e o programa o trata
+ * pelo ID interno p + 1 (ver baseReordenada).
+ */
+void reordenarPelaCurva(std::vector<Imovel>& imoveis);
+
+/**
+ * @brief Indica se algum imóvel não está na posição do seu ID (base reordenada)
+ */
+bool baseReordenada(const std::vector<Imovel>& imoveis);
+
+/**
+ * @brief Ordem de visita pela curva de Hilbert
+ *
+ * A curva é cortada no ponto onde ficaria o corretor e percorrida a partir
+ * dali nos dois sentidos (dando a volta pelo início ou pelo fim); fica o
+ * sentido de menor distância total.
+ *
+ * @tparam Provedor Política de distância (classe de distancia.h; nó 0 = corretor)
+ * @param pontos Coordenadas dos imóveis do corretor
+ * @param latInicio Latitude de partida (localização do corretor)
+ * @param lonInicio Longitude de partida
+ * @param provedor Provedor de distâncias da rota
+ * @return Posições (em pontos) na ordem de visita
+ */
+template <typename Provedor>
+std::vector<int> rotaCurva(const BlocoCoordenadas& pontos, double latInicio, double lonInicio,
+                           Provedor& provedor) {
+    int n = static_cast<int>(pontos.tamanho());
+    if (n == 0) {
+        return {};
+    }
+    GradeCurva grade;
+    grade.incluir(latInicio, lonInicio);
+    for (int p = 0; p < n; ++p) {
+        grade.incluir(pontos.latitude[p], pontos.longitude[p]);
+    }
+    std::vector<std::pair<std::uint32_t, int>> chaves(n);
+    for (int p = 0; p < n; ++p) {
+        chaves[p] = {grade.indice(pontos.latitude[p], pontos.longitude[p]), p};
+    }
+    std::sort(chaves.begin(), chaves.end());
+    int corte = static_cast<int>(std::lower_bound(chaves.begin(), chaves.end(),
+                                                  std::make_pair(grade.indice(latInicio, lonInicio), 0)) -
+                                 chaves.begin());
+
+    std::vector<int> avante(n), reverso(n);
+    for (int i = 0; i < n; ++i) {
+        avante[i] = chaves[(corte + i) % n].second;
+        reverso[i] = chaves[(corte - 1 - i + 2 * n) % n].second;
+    }
+    auto comprimento = [&](const std::vector<int>& rota) {
+        double total = 0.0;
+        int noAtual = 0;
+        for (int p : rota) {
+            total += provedor.distancia(noAtual, p + 1);
+            noAtual = p + 1;
+        }
+        return total;
+    };
+    return comprimento(reverso) < comprimento(avante) ? reverso : avante;
+}
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file dados.cpp
+ * @brief Implementação da leitura e validação da base
+ */
+
+#include "dados.h"
+#include "metricas.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+/// Imóveis lidos entre duas liberações do trecho já consumido da entrada
+constexpr int IMOVEIS_POR_DESCARTE = 1 << 16;
+
+/// Menor texto de cada registro, com o espaço que o separa do próximo ("1 0 0 0 x", "1 x", "x 1 0 0 1 y")
+constexpr std::size_t BYTES_MINIMOS_CORRETOR = 10;
+constexpr std::size_t BYTES_MINIMOS_CLIENTE = 4;
+constexpr std::size_t BYTES_MINIMOS_IMOVEL = 12;
+
+/**
+ * Registros declarados que ainda cabem no resto da entrada (o último pode
+ * vir sem separador)
+ */
+int registrosQueCabem(const LeitorEntrada& entrada, int declarados, std::size_t bytesMinimos) {
+    std::size_t cabem = entrada.bytesRestantes() / bytesMinimos + 1;
+    return static_cast<int>(std::min(static_cast<std::size_t>(declarados), cabem));
+}
+
+} // namespace
+
+/**
+ * Valida se um número está dentro de um intervalo válido
+ */
+bool validarIntervalo(double valor, double min, double max, const std::string& nome) {
+    if (valor < min || valor > max) {
+        std::cerr << "Erro: " << nome << " deve estar entre " << min << " e " << max << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Lê e valida um corretor
+ */
+Corretor lerCorretor(LeitorEntrada& entrada, int numero, ArenaTextos& textos, ProjecaoBase projecao) {
+    std::string_view telefone;
+    int avaliador;
+    double lat, lon;
+    
+    if (!(entrada.lerPalavra(telefone) && entrada.lerInteiro(avaliador) &&
+          entrada.lerReal(lat) && entrada.lerReal(lon))) {
+        throw std::runtime_error("Erro: dados do corretor " + std::to_string(numero) + " inválidos");
+    }
+    
+    // Validar dados
+    if (avaliador != 0 && avaliador != 1) {
+        throw std::runtime_error("Erro: avaliador deve ser 0 ou 1");
+    }
+    if (!validarIntervalo(lat, -90.0, 90.0, "latitude")) {
+        throw std::runtime_error("Erro: latitude inválida");
+    }
+    if (!validarIntervalo(lon, -180.0, 180.0, "longitude")) {
+        throw std::runtime_error("Erro: longitude inválida");
+    }
+    
+    std::string_view nome = entrada.lerRestoDaLinha();
+    
+    if (nome.empty()) {
+        throw std::runtime_error("Erro: nome do corretor não pode estar vazio");
+    }
+    
+    if (projecao == ProjecaoBase::Rotas) {
+        return Corretor(numero, {}, avaliador == 1, lat, lon, {});
+    }
+    return Corretor(numero, textos.guardar(telefone), avaliador == 1, lat, lon, textos.guardar(nome));
+}
+
+/**
+ * Lê e valida um imóvel
+ */
+Imovel lerImovel(LeitorEntrada& entrada, int numero, int numClientes, ArenaTextos& textos,
+                 ProjecaoBase projecao) {
+    std::string_view tipo;
+    int propId;
+    double lat, lon, preco;
+    
+    if (!(entrada.lerPalavra(tipo) && entrada.lerInteiro(propId) && entrada.lerReal(lat) &&
+          entrada.lerReal(lon) && entrada.lerReal(preco))) {
+        throw std::runtime_error("Erro: dados do imóvel " + std::to_string(numero) + " inválidos");
+    }
+    
+    // Validar dados
+    if (propId <= 0 || propId > numClientes) {
+        throw std::runtime_error("Erro: ID do proprietário inválido");
+    }
+    if (!validarIntervalo(lat, -90.0, 90.0, "latitude")) {
+        throw std::runtime_error("Erro: latitude inválida");
+    }
+    if (!validarIntervalo(lon, -180.0, 180.0, "longitude")) {
+        throw std::runtime_error("Erro: longitude inválida");
+    }
+    if (preco <= 0) {
+        throw std::runtime_error("Erro: preço deve ser positivo");
+    }
+    
+    std::string_view endereco = entrada.lerRestoDaLinha();
+    
+    if (endereco.empty()) {
+        throw std::runtime_error("Erro: endereço não pode estar vazio");
+    }
+    
+    if (projecao == ProjecaoBase::Rotas) {
+        endereco = {};
+    } else {
+        endereco = textos.guardar(endereco);
+    }
+    return Imovel(numero, Imovel::stringToTipo(tipo), propId, lat, lon, preco, endereco);
+}
+
+/**
+ * Lê os corretores e os clientes
+ */
+int lerCorretoresEClientes(LeitorEntrada& entrada,
+                           std::vector<Corretor>& corretores,
+                           std::vector<Cliente>& clientes,
+                           ArenaTextos& textos,
+                           ProjecaoBase projecao) {
+    // Ler corretores
+    int numCorretores;
+    if (!entrada.lerInteiro(numCorretores) || numCorretores <= 0) {
+        throw std::runtime_error("Erro: número de corretores inválido");
+    }
+    corretores.reserve(registrosQueCabem(entrada, numCorretores, BYTES_MINIMOS_CORRETOR));
+    
+    for (int i = 0; i < numCorretores; ++i) {
+        corretores.push_back(lerCorretor(entrada, i + 1, textos, projecao));
+    }
+    
+    // Ler clientes
+    int numClientes;
+    if (!entrada.lerInteiro(numClientes) || numClientes < 0) {
+        throw std::runtime_error("Erro: número de clientes inválido");
+    }
+    if (projecao == ProjecaoBase::Completa) {
+        clientes.reserve(registrosQueCabem(entrada, numClientes, BYTES_MINIMOS_CLIENTE));
+    }
+    
+    for (int i = 0; i < numClientes; ++i) {
+        std::string_view telefone;
+        if (!entrada.lerPalavra(telefone)) {
+            throw std::runtime_error("Erro: telefone do cliente " + std::to_string(i + 1) + " inválido");
+        }
+        
+        std::string_view nome = entrada.lerRestoDaLinha();
+        
+        if (nome.empty()) {
+            throw std::runtime_error("Erro: nome do cliente não pode estar vazio");
+        }
+        
+        if (projecao == ProjecaoBase::Completa) {
+            clientes.emplace_back(i + 1, textos.guardar(telefone), textos.guardar(nome));
+        }
+    }
+    return numClientes;
+}
+
+/**
+ * Lê o número de imóveis
+ */
+int lerNumeroImoveis(LeitorEntrada& entrada) {
+    int numImoveis;
+    if (!entrada.lerInteiro(numImoveis) || numImoveis <= 0) {
+        throw std::runtime_error("Erro: número de imóveis inválido");
+    }
+    return numImoveis;
+}
+
+/**
+ * Lê um trecho dos imóveis
+ */
+void lerImoveis(LeitorEntrada& entrada, int primeiro, int quantidade, int numClientes,
+                ArenaTextos& textos, std::vector<Imovel>& imoveis, ProjecaoBase projecao) {
+    for (int i = primeiro; i < primeiro + quantidade; ++i) {
+        imoveis.push_back(lerImovel(entrada, i + 1, numClientes, textos, projecao));
+        if ((i + 1) % IMOVEIS_POR_DESCARTE == 0) {
+            entrada.descartarConsumido(); // os textos já foram copiados para a arena
+        }
+    }
+}
+
+/**
+ * Quantos dos imóveis declarados ainda cabem no resto da entrada
+ */
+int imoveisQueCabem(const LeitorEntrada& entrada, int declarados) {
+    return registrosQueCabem(entrada, declarados, BYTES_MINIMOS_IMOVEL);
+}
+
+/**
+ * Lê e valida os dados de entrada
+ * 
+ * Os campos são extraídos do buffer do LeitorEntrada com a mesma semântica
+ * de std::cin; nomes, telefones e endereços chegam como views do buffer e
+ * são copiados uma única vez, em sequência, para a arena de textos (só na
+ * projeção completa; na das rotas, eles são conferidos e descartados).
+ */
+int lerDados(LeitorEntrada& entrada,
+             std::vector<Corretor>& corretores, 
+             std::vector<Cliente>& clientes, 
+             std::vector<Imovel>& imoveis,
+             ArenaTextos& textos,
+             ProjecaoBase projecao) {
+    int numClientes = lerCorretoresEClientes(entrada, corretores, clientes, textos, projecao);
+    
+    // Ler imóveis
+    int numImoveis = lerNumeroImoveis(entrada);
+    imoveis.reserve(imoveisQueCabem(entrada, numImoveis));
+    lerImoveis(entrada, 0, numImoveis, numClientes, textos, imoveis, projecao);
+    METRICA_CONTAR(bytesLidos, entrada.bytesConsumidos());
+    return numClientes;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file dados.h
+ * @brief Leitura e validação da base de corretores, clientes e imóveis
+ * 
+ * As funções de registro individual (lerCorretor, lerImovel) são usadas
+ * tanto na leitura da entrada completa quanto nos comandos do modo serviço,
+ * para que ambos apliquem as mesmas validações e mensagens de erro.
+ *
+ * A projeção (ProjecaoBase) escolhe o que a leitura guarda: todos os campos
+ * ou só os que as rotas usam. Os campos descartados continuam validados,
+ * então uma entrada é aceita ou recusada com a mesma mensagem nas duas.
+ */
+
+#ifndef DADOS_H
+#define DADOS_H
+
+#include <string>
+#include <vector>
+#include "cliente.h"
+#include "corretor.h"
+#include "imovel.h"
+#include "leitor.h"
+#include "textos.h"
+
+/**
+ * @struct BaseDados
+ * @brief Uma base completa (por exemplo, uma região do modo lote)
+ * 
+ * Os IDs de corretores, clientes e imóveis são a posição de cada um na sua
+ * base, então bases diferentes podem ser carregadas ao mesmo tempo.
+ */
+struct BaseDados {
+    std::vector<Corretor> corretores;
+    std::vector<Cliente> clientes;
+    std::vector<Imovel> imoveis;
+    ArenaTextos textos; ///< Nomes, telefones e endereços das entidades acima
+};
+
+/**
+ * @enum ProjecaoBase
+ * @brief Campos da base guardados pela leitura
+ */
+enum class ProjecaoBase {
+    Completa, ///< Todos os campos, com nomes, telefones, endereços e clientes (snapshot, biblioteca)
+    Rotas     ///< Só o que a atribuição e as rotas usam: textos ficam vazios e clientes são apenas contados
+};
+
+/**
+ * @brief Valida se um número está dentro de um intervalo válido
+ * @return false (após informar o erro na saída de erro) se estiver fora
+ */
+bool validarIntervalo(double valor, double min, double max, const std::string& nome);
+
+/**
+ * @brief Lê e valida um corretor ("telefone avaliador latitude longitude nome")
+ * @param entrada Leitor posicionado no início do registro
+ * @param numero Número do corretor: é o seu ID e aparece nas mensagens de erro
+ * @param textos Arena que recebe nome e telefone
+ * @param projecao Com ProjecaoBase::Rotas, nome e telefone ficam vazios
+ * @return Corretor criado
+ * @throws std::runtime_error se algum campo for inválido
+ */
+Corretor lerCorretor(LeitorEntrada& entrada, int numero, ArenaTextos& textos,
+                     ProjecaoBase projecao = ProjecaoBase::Completa);
+
+/**
+ * @brief Lê e valida um imóvel ("tipo proprietário latitude longitude preço endereço")
+ * @param entrada Leitor posicionado no início do registro
+ * @param numero Número do imóvel: é o seu ID e aparece nas mensagens de erro
+ * @param numClientes Número de clientes cadastrados (limite do ID do proprietário)
+ * @param textos Arena que recebe o endereço
+ * @param projecao Com ProjecaoBase::Rotas, o endereço fica vazio
+ * @return Imóvel criado
+ * @throws std::runtime_error se algum campo for inválido
+ */
+Imovel lerImovel(LeitorEntrada& entrada, int numero, int numClientes, ArenaTextos& textos,
+                 ProjecaoBase projecao = ProjecaoBase::Completa);
+
+/**
+ * @brief Lê os corretores e os clientes (as duas primeiras seções da entrada)
+ * @param textos Arena que recebe nomes e telefones
+ * @param projecao Com ProjecaoBase::Rotas, os clientes são validados mas não entram em clientes
+ * @return Número de clientes da entrada
+ * @throws std::runtime_error se algum registro for inválido
+ */
+int lerCorretoresEClientes(LeitorEntrada& entrada,
+                           std::vector<Corretor>& corretores,
+                           std::vector<Cliente>& clientes,
+                           ArenaTextos& textos,
+                           ProjecaoBase projecao = ProjecaoBase::Completa);
+
+/**
+ * @brief Lê o número de imóveis que abre a última seção da entrada
+ * @throws std::runtime_error se não for um número positivo
+ */
+int lerNumeroImoveis(LeitorEntrada& entrada);
+
+/**
+ * @brief Lê os imóveis de posições primeiro a primeiro + quantidade - 1 (a partir de 0)
+ *
+ * Libera periodicamente o trecho já consumido da entrada; a posição é a
+ * da base inteira, então ler em vários blocos libera nos mesmos pontos
+ * que ler de uma vez.
+ *
+ * @param numClientes Número de clientes cadastrados (limite do ID do proprietário)
+ * @param textos Arena que recebe os endereços
+ * @param imoveis Vetor ao qual os imóveis são acrescentados
+ * @param projecao Campos guardados (ver lerImovel)
+ * @throws std::runtime_error se algum registro for inválido
+ */
+void lerImoveis(LeitorEntrada& entrada, int primeiro, int quantidade, int numClientes,
+                ArenaTextos& textos, std::vector<Imovel>& imoveis,
+                ProjecaoBase projecao = ProjecaoBase::Completa);
+
+/**
+ * @brief Quantos dos imóveis declarados ainda cabem no resto da entrada
+ *
+ * Limite para reservas feitas a partir da contagem declarada, antes de os
+ * registros serem validados: uma entrada truncada que declara bilhões de
+ * imóveis deve falhar no primeiro registro ausente, não na alocação.
+ */
+int imoveisQueCabem(const LeitorEntrada& entrada, int declarados);
+
+/**
+ * @brief Lê e valida os dados de entrada completos
+ * @param textos Arena que recebe nomes, telefones e endereços
+ * @param projecao Campos guardados (ver ProjecaoBase)
+ * @return Número de clientes da entrada (clientes fica vazio com ProjecaoBase::Rotas)
+ * @throws std::runtime_error se algum registro for inválido
+ */
+int lerDados(LeitorEntrada& entrada,
+             std::vector<Corretor>& corretores,
+             std::vector<Cliente>& clientes,
+             std::vector<Imovel>& imoveis,
+             ArenaTextos& textos,
+             ProjecaoBase projecao = ProjecaoBase::Completa);
+
+#endif
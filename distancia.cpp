@@ -0,0 +1,171 @@
+/**
+ * @file distancia.cpp
+ * @brief Implementação dos provedores de distância
+ */
+
+#include "distancia.h"
+#include <stdexcept>
+
+namespace {
+
+constexpr int LIMITE_MATRIZ_DENSA = 2048; // Acima disso o cache usa tabela hash
+constexpr double MARGEM_EQUIRETANGULAR = 1e-3; // 0,1%, ver distancia.h
+constexpr std::size_t LIMITE_MATRIZ_REDE = 512; // Nós distintos da rede até os quais a rota usa a matriz completa
+
+const RedeViaria& redeObrigatoria(const RedeViaria* rede) {
+    if (!rede) {
+        throw std::runtime_error("Erro: --distance=road exige --road-network");
+    }
+    return *rede;
+}
+
+} // namespace
+
+NosRota::NosRota(const BlocoCoordenadas& pontos, double latInicio, double lonInicio) {
+    std::size_t n = pontos.tamanho() + 1;
+    lat.reserve(n);
+    lon.reserve(n);
+    lat.push_back(latInicio);
+    lon.push_back(lonInicio);
+    lat.insert(lat.end(), pontos.latitude.begin(), pontos.latitude.end());
+    lon.insert(lon.end(), pontos.longitude.begin(), pontos.longitude.end());
+}
+
+ProvedorCache::ProvedorCache(const BlocoCoordenadas& pontos, double latInicio, double lonInicio)
+    : nos(pontos, latInicio, lonInicio), densa(nos.tamanho() <= LIMITE_MATRIZ_DENSA) {
+    if (densa) {
+        std::size_t n = static_cast<std::size_t>(nos.tamanho());
+        matriz.assign(n * (n + 1) / 2, std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+ProvedorEquiretangular::ProvedorEquiretangular(const BlocoCoordenadas& pontos, double latInicio, double lonInicio) {
+    latRad.reserve(pontos.tamanho() + 1);
+    lonRad.reserve(pontos.tamanho() + 1);
+    latRad.push_back(latInicio * M_PI / 180.0);
+    lonRad.push_back(lonInicio * M_PI / 180.0);
+    latRad.insert(latRad.end(), pontos.latRad.begin(), pontos.latRad.end());
+    lonRad.insert(lonRad.end(), pontos.lonRad.begin(), pontos.lonRad.end());
+}
+
+double ProvedorEquiretangular::margemRelativa() const {
+    return MARGEM_EQUIRETANGULAR;
+}
+
+/**
+ * Liga cada nó da rota à rede; com poucos nós distintos, calcula de uma vez
+ * a matriz entre eles
+ */
+ProvedorRede::ProvedorRede(const BlocoCoordenadas& pontos, double latInicio, double lonInicio,
+                           const RedeViaria* redeViaria)
+    : nos(pontos, latInicio, lonInicio), rede(redeObrigatoria(redeViaria)) {
+    int n = nos.tamanho();
+    local.resize(n);
+    acesso.resize(n);
+    std::unordered_map<int, int> localDoNo;
+    for (int u = 0; u < n; ++u) {
+        int no = rede.encaixar(nos.lat[u], nos.lon[u], acesso[u]);
+        auto [it, inserido] = localDoNo.try_emplace(no, static_cast<int>(nosRede.size()));
+        if (inserido) {
+            nosRede.push_back(no);
+        }
+        local[u] = it->second;
+    }
+    if (nosRede.size() <= LIMITE_MATRIZ_REDE) {
+        rede.matrizDistancias(nosRede, busca(), matriz);
+        contadores.calculos += nosRede.size();
+    }
+}
+
+double ProvedorRede::distancia(int u, int v) {
+    contadores.consultas++;
+    int a = local[u];
+    int b = local[v];
+    if (a == b) {
+        contadores.calculos++;
+        return u == v ? 0.0 : nos.haversineNos(u, v);
+    }
+    if (!matriz.empty()) {
+        contadores.acertos++;
+        return acesso[u] + matriz[static_cast<std::size_t>(a) * nosRede.size() + b] + acesso[v];
+    }
+    if (a > b) {
+        std::swap(a, b);
+    }
+    std::uint64_t chave = (static_cast<std::uint64_t>(a) << 32) | static_cast<std::uint32_t>(b);
+    auto [it, inserido] = tabela.try_emplace(chave, 0.0);
+    if (inserido) {
+        contadores.calculos++;
+        it->second = rede.distancia(nosRede[a], nosRede[b], busca());
+    } else {
+        contadores.acertos++;
+    }
+    return acesso[u] + it->second + acesso[v];
+}
+
+/**
+ * A memória de trabalho tem o tamanho da rede: uma por thread, reaproveitada entre rotas
+ */
+RedeViaria::Busca& ProvedorRede::busca() {
+    thread_local RedeViaria::Busca porThread;
+    return porThread;
+}
+
+EstatisticasDistancia& EstatisticasDistancia::operator+=(const EstatisticasDistancia& outra) {
+    consultas += outra.consultas;
+    acertos += outra.acertos;
+    calculos += outra.calculos;
+    imoveis += outra.imoveis;
+    paradas += outra.paradas;
+    return *this;
+}
+
+/**
+ * @brief Distância entre dois pontos com a métrica do provedor
+ * 
+ * Os radianos são calculados com a mesma expressão de BlocoCoordenadas, então
+ * o valor coincide bit a bit com o do provedor correspondente.
+ */
+double distanciaEntre(TipoDistancia tipo, double lat1, double lon1, double lat2, double lon2) {
+    if (tipo == TipoDistancia::Rede) {
+        throw std::runtime_error("Erro: a distância pela rede viária não está disponível no modo serviço");
+    }
+    if (tipo == TipoDistancia::Equiretangular) {
+        return equiretangularRad(lat1 * M_PI / 180.0, lon1 * M_PI / 180.0,
+                                 lat2 * M_PI / 180.0, lon2 * M_PI / 180.0);
+    }
+    return haversine(lat1, lon1, lat2, lon2);
+}
+
+/**
+ * @brief Converte o nome usado em --distance
+ */
+TipoDistancia tipoDistanciaPorNome(const std::string& nome) {
+    if (nome == "haversine") {
+        return TipoDistancia::Haversine;
+    } else if (nome == "cache") {
+        return TipoDistancia::Cache;
+    } else if (nome == "equirect") {
+        return TipoDistancia::Equiretangular;
+    } else if (nome == "road") {
+        return TipoDistancia::Rede;
+    }
+    throw std::runtime_error("Erro: valor inválido para --distance: " + nome + " (use haversine, cache, equirect ou road)");
+}
+
+/**
+ * @brief Nome do provedor, como aceito em --distance
+ */
+const char* nomeTipoDistancia(TipoDistancia tipo) {
+    switch (tipo) {
+        case TipoDistancia::Cache:
+            return "cache";
+        case TipoDistancia::Equiretangular:
+            return "equirect";
+        case TipoDistancia::Rede:
+            return "road";
+        case TipoDistancia::Haversine:
+        default:
+            return "haversine";
+    }
+}
@@ -0,0 +1,259 @@
+/**
+ * @file distancia.h
+ * @brief Provedores de distância entre os pontos de uma rota
+ * 
+ * Toda distância usada na geração de uma rota (escolha do vizinho, busca
+ * local, tempo de deslocamento) passa por um ProvedorDistancia, escolhido em
+ * tempo de execução com --distance:
+ * 
+ *   - haversine: fórmula do enunciado, sem cache (padrão);
+ *   - cache: haversine com matriz por rota, densa até 2048 pontos e esparsa
+ *     (tabela hash) acima disso; o resultado é idêntico ao do haversine;
+ *   - equirect: aproximação equirretangular sobre os radianos pré-calculados.
+ *     Para pares a até 100 km e latitudes entre -80° e 80°, o erro relativo
+ *     fica abaixo de 0,1% (medido: 0,04%); fora disso ele cresce e a rota
+ *     deixa de ser garantidamente a mesma de uma varredura com essa métrica;
+ *   - road: distância pela malha viária (--road-network, ver rede_viaria.h).
+ *     Cada ponto é ligado ao nó mais próximo da rede; a rota usa a matriz
+ *     completa entre os seus nós quando eles são poucos e consultas avulsas
+ *     (com cache) nas rotas grandes.
+ * 
+ * Os pontos são identificados por nós: 0 é a localização do corretor e
+ * p + 1 é o ponto na posição p do bloco de coordenadas da rota.
+ *
+ * Cada provedor é uma classe final que também serve de política para os
+ * modelos de agendamento.h: instanciados com o tipo concreto, os laços da
+ * rota chamam distancia() sem despacho virtual e o compilador a expande.
+ * A interface virtual continua disponível para a busca local.
+ */
+
+#ifndef DISTANCIA_H
+#define DISTANCIA_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "coordenadas.h"
+#include "geografia.h"
+#include "rede_viaria.h"
+
+/**
+ * @enum TipoDistancia
+ * @brief Provedor de distância usado na geração das rotas
+ */
+enum class TipoDistancia {
+    Haversine,     ///< Haversine exato, sem cache
+    Cache,         ///< Haversine com matriz de distâncias por rota
+    Equiretangular, ///< Aproximação equirretangular (escala urbana)
+    Rede            ///< Distância pela malha viária
+};
+
+/**
+ * @struct EstatisticasDistancia
+ * @brief Contadores de uso de um provedor, somáveis entre rotas
+ */
+struct EstatisticasDistancia {
+    std::uint64_t consultas = 0; ///< Distâncias pedidas ao provedor
+    std::uint64_t acertos = 0;   ///< Consultas respondidas pelo cache
+    std::uint64_t calculos = 0;  ///< Distâncias efetivamente calculadas
+    std::uint64_t imoveis = 0;   ///< Imóveis das rotas
+    std::uint64_t paradas = 0;   ///< Pontos ordenados pelas rotas (menos que imoveis com --collapse-m)
+
+    EstatisticasDistancia& operator+=(const EstatisticasDistancia& outra);
+};
+
+/**
+ * @class ProvedorDistancia
+ * @brief Interface dos provedores de distância de uma rota
+ */
+class ProvedorDistancia {
+public:
+    virtual ~ProvedorDistancia() = default;
+
+    /**
+     * @brief Distância em km entre dois nós da rota
+     */
+    virtual double distancia(int u, int v) = 0;
+
+    /**
+     * @brief Erro relativo máximo em relação a haversine, usado pelo índice espacial
+     * para não descartar candidatos que esta métrica ainda poderia escolher
+     */
+    virtual double margemRelativa() const { return 0.0; }
+
+    /**
+     * @brief Contadores acumulados desde a criação
+     */
+    const EstatisticasDistancia& estatisticas() const { return contadores; }
+
+protected:
+    EstatisticasDistancia contadores;
+};
+
+/**
+ * @brief Aproximação equirretangular entre dois pontos em radianos
+ */
+inline double equiretangularRad(double lat1, double lon1, double lat2, double lon2) {
+    double dlon = lon2 - lon1;
+    if (dlon > M_PI) {
+        dlon -= 2 * M_PI;
+    } else if (dlon < -M_PI) {
+        dlon += 2 * M_PI;
+    }
+    double x = dlon * std::cos((lat1 + lat2) / 2);
+    double y = lat2 - lat1;
+    return EARTH_R * std::sqrt(x * x + y * y);
+}
+
+/**
+ * @class NosRota
+ * @brief Coordenadas de todos os nós da rota (nó 0 = corretor)
+ */
+class NosRota {
+public:
+    NosRota(const BlocoCoordenadas& pontos, double latInicio, double lonInicio);
+
+    double haversineNos(int u, int v) const {
+        return haversine(lat[u], lon[u], lat[v], lon[v]);
+    }
+
+    int tamanho() const { return static_cast<int>(lat.size()); }
+
+    std::vector<double> lat, lon;
+};
+
+/**
+ * @class ProvedorHaversine
+ * @brief Haversine exato, calculado a cada consulta
+ */
+class ProvedorHaversine final : public ProvedorDistancia {
+public:
+    ProvedorHaversine(const BlocoCoordenadas& pontos, double latInicio, double lonInicio)
+        : nos(pontos, latInicio, lonInicio) {}
+
+    double distancia(int u, int v) override {
+        contadores.consultas++;
+        contadores.calculos++;
+        return nos.haversineNos(u, v);
+    }
+
+private:
+    NosRota nos;
+};
+
+/**
+ * @class ProvedorCache
+ * @brief Haversine com matriz triangular densa (rotas pequenas) ou tabela hash
+ *
+ * haversine(a, b) == haversine(b, a) bit a bit, então cada par não ordenado
+ * é guardado uma única vez.
+ */
+class ProvedorCache final : public ProvedorDistancia {
+public:
+    ProvedorCache(const BlocoCoordenadas& pontos, double latInicio, double lonInicio);
+
+    double distancia(int u, int v) override {
+        contadores.consultas++;
+        if (u > v) {
+            std::swap(u, v);
+        }
+        if (densa) {
+            double& valor = matriz[static_cast<std::size_t>(v) * (v + 1) / 2 + u];
+            if (std::isnan(valor)) {
+                contadores.calculos++;
+                valor = nos.haversineNos(u, v);
+            } else {
+                contadores.acertos++;
+            }
+            return valor;
+        }
+        std::uint64_t chave = (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint32_t>(v);
+        auto [it, inserido] = tabela.try_emplace(chave, 0.0);
+        if (inserido) {
+            contadores.calculos++;
+            it->second = nos.haversineNos(u, v);
+        } else {
+            contadores.acertos++;
+        }
+        return it->second;
+    }
+
+private:
+    NosRota nos;
+    bool densa;
+    std::vector<double> matriz;
+    std::unordered_map<std::uint64_t, double> tabela;
+};
+
+/**
+ * @class ProvedorEquiretangular
+ * @brief Aproximação equirretangular: x = Δλ·cos(φ médio), y = Δφ
+ */
+class ProvedorEquiretangular final : public ProvedorDistancia {
+public:
+    ProvedorEquiretangular(const BlocoCoordenadas& pontos, double latInicio, double lonInicio);
+
+    double distancia(int u, int v) override {
+        contadores.consultas++;
+        contadores.calculos++;
+        return equiretangularRad(latRad[u], lonRad[u], latRad[v], lonRad[v]);
+    }
+
+    double margemRelativa() const override;
+
+private:
+    std::vector<double> latRad, lonRad;
+};
+
+/**
+ * @class ProvedorRede
+ * @brief Distância pela malha viária
+ *
+ * Trecho em linha reta até o nó de cada ponta mais o caminho entre os nós.
+ * Pontos ligados ao mesmo nó ficam a distância em linha reta entre si. Pela
+ * desigualdade triangular, o resultado nunca é menor que haversine, então o
+ * índice espacial não precisa de margem.
+ */
+class ProvedorRede final : public ProvedorDistancia {
+public:
+    /**
+     * @throws std::runtime_error se rede for nula (--distance=road sem --road-network)
+     */
+    ProvedorRede(const BlocoCoordenadas& pontos, double latInicio, double lonInicio, const RedeViaria* rede);
+
+    double distancia(int u, int v) override;
+
+private:
+    static RedeViaria::Busca& busca();
+
+    NosRota nos;
+    const RedeViaria& rede;
+    std::vector<int> local;          ///< Posição do nó da rede de cada nó da rota em nosRede
+    std::vector<double> acesso;      ///< Trecho em linha reta de cada nó da rota até a rede
+    std::vector<int> nosRede;        ///< Nós distintos da rede usados pela rota
+    std::vector<double> matriz;      ///< Distâncias entre nosRede (vazia nas rotas grandes)
+    std::unordered_map<std::uint64_t, double> tabela;
+};
+
+/**
+ * @brief Distância em km entre dois pontos com a métrica do provedor (sem cache)
+ * @param tipo Provedor cuja métrica é usada (cache equivale a haversine)
+ * @throws std::runtime_error para TipoDistancia::Rede, que depende dos nós da rota
+ */
+double distanciaEntre(TipoDistancia tipo, double lat1, double lon1, double lat2, double lon2);
+
+/**
+ * @brief Converte o nome usado em --distance ("haversine", "cache", "equirect", "road")
+ * @throws std::runtime_error se o nome não for reconhecido
+ */
+TipoDistancia tipoDistanciaPorNome(const std::string& nome);
+
+/**
+ * @brief Nome do provedor, como aceito em --distance
+ */
+const char* nomeTipoDistancia(TipoDistancia tipo);
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ * @file esteira.cpp
+ * @brief Implementação do modo esteira
+ */
+
+#include "esteira.h"
+#include "atribuicao.h"
+#include "dados.h"
+#include "leitor.h"
+#include "metricas.h"
+#include "paralelo.h"
+#include "saida.h"
+#include "textos.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Imóveis entregues de uma vez pela thread de leitura
+constexpr int IMOVEIS_POR_BLOCO = 4096;
+
+/// Blocos lidos que podem esperar pela atribuição
+constexpr std::size_t BLOCOS_NA_FILA = 16;
+
+/**
+ * Fila entre duas threads com capacidade fixa: quem coloca espera enquanto
+ * ela estiver cheia, quem retira espera enquanto estiver vazia
+ */
+template <typename T>
+class FilaLimitada {
+public:
+    explicit FilaLimitada(std::size_t capacidade) : capacidade(capacidade) {}
+
+    /// Espera haver espaço; false se a fila foi fechada (o item é descartado)
+    bool colocar(T item) {
+        std::unique_lock<std::mutex> trava(mutex);
+        temEspaco.wait(trava, [&] { return itens.size() < capacidade || fechada; });
+        if (fechada) {
+            return false;
+        }
+        itens.push_back(std::move(item));
+        temItem.notify_one();
+        return true;
+    }
+
+    /// Espera um item; false quando a fila está fechada e vazia
+    bool retirar(T& item) {
+        std::unique_lock<std::mutex> trava(mutex);
+        temItem.wait(trava, [&] { return !itens.empty() || fechada; });
+        if (itens.empty()) {
+            return false;
+        }
+        item = std::move(itens.front());
+        itens.pop_front();
+        temEspaco.notify_one();
+        return true;
+    }
+
+    /// Não aceita mais itens; os que já estão na fila ainda podem ser retirados
+    void fechar() {
+        std::lock_guard<std::mutex> trava(mutex);
+        fechada = true;
+        temItem.notify_all();
+        temEspaco.notify_all();
+    }
+
+private:
+    std::size_t capacidade;
+    std::deque<T> itens;
+    bool fechada = false;
+    std::mutex mutex;
+    std::condition_variable temItem;
+    std::condition_variable temEspaco;
+};
+
+/**
+ * Agendas geradas e ainda não escritas, uma posição por corretor com imóveis
+ */
+struct AgendasPendentes {
+    std::vector<std::vector<Agendamento>> agendas;
+    std::vector<char> prontas;
+    std::size_t escritas = 0;  ///< As agendas 0 a escritas - 1 já foram escritas
+    bool interrompida = false; ///< Uma rota ou a escrita falhou: ninguém mais espera
+    std::mutex mutex;
+    std::condition_variable mudou;
+
+    void interromper() {
+        std::lock_guard<std::mutex> trava(mutex);
+        interrompida = true;
+        mudou.notify_all();
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Agenda a base no modo esteira
+ */
+int executarEsteira(const Opcoes& opcoes) {
+    auto inicioExecucao = std::chrono::steady_clock::now();
+    std::unique_ptr<LeitorEntrada> entrada = opcoes.arquivoEntrada.empty()
+        ? std::make_unique<LeitorEntrada>(0)
+        : std::make_unique<LeitorEntrada>(opcoes.arquivoEntrada);
+
+    std::vector<Corretor> corretores;
+    std::vector<Cliente> clientes;
+    std::vector<Imovel> imoveis;
+    ArenaTextos textos;
+    int numClientes = lerCorretoresEClientes(*entrada, corretores, clientes, textos, ProjecaoBase::Rotas);
+    int numImoveis = lerNumeroImoveis(*entrada);
+    bool cabemTodos = imoveisQueCabem(*entrada, numImoveis) == numImoveis;
+    imoveis.reserve(imoveisQueCabem(*entrada, numImoveis));
+
+    // Com o total conhecido, as faixas do Round-Robin já podem ser montadas
+    std::vector<const Corretor*> candidatos;
+    for (const auto& corretor : corretores) {
+        if (corretor.isAvaliador()) {
+            candidatos.push_back(&corretor);
+        }
+    }
+    // Uma contagem maior do que a entrada comporta (entrada truncada) não é
+    // reservada: a leitura falha no primeiro imóvel ausente
+    bool atribuirNaLeitura = opcoes.atribuicao == ModoAtribuicao::RoundRobin && !candidatos.empty() && cabemTodos;
+    Atribuicao atribuicao;
+    if (atribuirNaLeitura) {
+        atribuicao = reservarRoundRobin(numImoveis, candidatos);
+    }
+
+    // Leitura dos imóveis numa thread própria; a atual atribui os blocos recebidos
+    FilaLimitada<std::vector<Imovel>> fila(BLOCOS_NA_FILA);
+    std::exception_ptr erroLeitura;
+    std::thread leitura([&]() {
+        try {
+            for (int primeiro = 0; primeiro < numImoveis; primeiro += IMOVEIS_POR_BLOCO) {
+                int quantidade = std::min(IMOVEIS_POR_BLOCO, numImoveis - primeiro);
+                std::vector<Imovel> bloco;
+                bloco.reserve(quantidade);
+                lerImoveis(*entrada, primeiro, quantidade, numClientes, textos, bloco, ProjecaoBase::Rotas);
+                if (!fila.colocar(std::move(bloco))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            erroLeitura = std::current_exception();
+        }
+        fila.fechar();
+    });
+    try {
+        std::vector<Imovel> bloco;
+        while (fila.retirar(bloco)) {
+            for (const Imovel& imovel : bloco) {
+                if (atribuirNaLeitura) {
+                    colocarRoundRobin(atribuicao, static_cast<int>(imoveis.size()), imovel.id);
+                }
+                imoveis.push_back(imovel);
+            }
+        }
+    } catch (...) {
+        fila.fechar();
+        leitura.join();
+        throw;
+    }
+    leitura.join();
+    if (erroLeitura) {
+        std::rethrow_exception(erroLeitura);
+    }
+    entrada.reset();
+    double leituraMs = milissegundosDesde(inicioExecucao);
+
+    // Mesmas verificações e mensagens da execução em fases
+    auto inicioFase = std::chrono::steady_clock::now();
+    std::vector<const Corretor*> avaliadores = selecionarAvaliadores(corretores, imoveis);
+    if (!atribuirNaLeitura) {
+        atribuicao = atribuirImoveis(imoveis, avaliadores, opcoes.atribuicao, opcoes.threads);
+    }
+    double atribuicaoMs = milissegundosDesde(inicioFase);
+
+    std::vector<int> comImoveis;
+    for (int k = 0; k < atribuicao.numAvaliadores(); ++k) {
+        if (!atribuicao.imoveisDe(k).vazia()) {
+            comImoveis.push_back(k);
+        }
+    }
+    int numRotas = static_cast<int>(comImoveis.size());
+    ConfiguracaoRota rota = opcoes.rota;
+    rota.threadsExato = std::max(1, opcoes.threads / std::max(1, numRotas));
+
+    // Rotas em ordem de ID, no máximo janela posições à frente da escrita
+    inicioFase = std::chrono::steady_clock::now();
+    const std::size_t janela = static_cast<std::size_t>(AGENDAS_POR_THREAD) * std::max(1, opcoes.threads);
+    AgendasPendentes pendentes;
+    pendentes.agendas.resize(numRotas);
+    pendentes.prontas.assign(numRotas, 0);
+    std::vector<double> kmPorRota(numRotas, 0.0);
+    std::vector<EstatisticasDistancia> usoDistancia(numRotas);
+    double primeiraAgendaMs = 0.0;
+
+    std::exception_ptr erroEscrita;
+    std::thread escrita([&]() {
+        try {
+            EscritorAgenda escritor(opcoes.formato);
+            for (int i = 0; i < numRotas; ++i) {
+                std::vector<Agendamento> agenda;
+                {
+                    std::unique_lock<std::mutex> trava(pendentes.mutex);
+                    pendentes.mudou.wait(trava, [&] { return pendentes.prontas[i] || pendentes.interrompida; });
+                    if (!pendentes.prontas[i]) {
+                        return;
+                    }
+                    agenda = std::move(pendentes.agendas[i]);
+                }
+                escritor.escreverCorretor(atribuicao.avaliadores[comImoveis[i]]->id, agenda);
+                if (i == 0) {
+                    primeiraAgendaMs = milissegundosDesde(inicioExecucao);
+                }
+                std::lock_guard<std::mutex> trava(pendentes.mutex);
+                pendentes.escritas = i + 1;
+                pendentes.mudou.notify_all();
+            }
+            escritor.finalizar();
+        } catch (...) {
+            erroEscrita = std::current_exception();
+            pendentes.interromper();
+        }
+    });
+
+    try {
+        executarEmParalelo(numRotas, opcoes.threads, [&](int i) {
+            {
+                std::unique_lock<std::mutex> trava(pendentes.mutex);
+                pendentes.mudou.wait(trava, [&] {
+                    return static_cast<std::size_t>(i) < pendentes.escritas + janela || pendentes.interrompida;
+                });
+                if (pendentes.interrompida) {
+                    return;
+                }
+            }
+            const Corretor& corretor = *atribuicao.avaliadores[comImoveis[i]];
+            std::vector<Agendamento> agenda;
+            try {
+                agenda = gerarAgendamentoCorretor(imoveis, corretor, atribuicao.imoveisDe(comImoveis[i]), rota,
+                                                  &usoDistancia[i]);
+            } catch (...) {
+                pendentes.interromper();
+                throw;
+            }
+            if (opcoes.relatarDistancia) {
+                kmPorRota[i] = distanciaPercorrida(imoveis, corretor, agenda);
+            }
+            std::lock_guard<std::mutex> trava(pendentes.mutex);
+            pendentes.agendas[i] = std::move(agenda);
+            pendentes.prontas[i] = 1;
+            pendentes.mudou.notify_all();
+        });
+    } catch (...) {
+        pendentes.interromper();
+        escrita.join();
+        throw;
+    }
+    escrita.join();
+    if (erroEscrita) {
+        std::rethrow_exception(erroEscrita);
+    }
+    double rotasMs = milissegundosDesde(inicioFase);
+
+    if (opcoes.relatarTempos) {
+        escreverTemposJson(std::cerr,
+                           {{"imoveis", imoveis.size()},
+                            {"corretores", corretores.size()},
+                            {"avaliadores", avaliadores.size()},
+                            {"threads", static_cast<std::size_t>(opcoes.threads)}},
+                           {{"leitura_ms", leituraMs},
+                            {"atribuicao_ms", atribuicaoMs},
+                            {"rotas_saida_ms", rotasMs},
+                            {"primeira_agenda_ms", primeiraAgendaMs},
+                            {"total_ms", milissegundosDesde(inicioExecucao)}});
+    }
+    double totalKm = 0.0;
+    for (double km : kmPorRota) {
+        totalKm += km;
+    }
+    EstatisticasDistancia total;
+    for (const auto& uso : usoDistancia) {
+        total += uso;
+    }
+    relatarRotas(std::cerr, opcoes, totalKm, total, total);
+    return 0;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file esteira.h
+ * @brief Modo esteira (--pipeline): leitura, atribuição, rotas e saída sobrepostas
+ *
+ * Em vez de fases estritas, as etapas rodam ao mesmo tempo, ligadas por
+ * filas de tamanho limitado:
+ *   - uma thread lê os imóveis e os entrega em blocos; enquanto isso, a
+ *     thread principal já os posiciona na faixa do seu avaliador
+ *     (Round-Robin; o agrupamento por cluster precisa da base inteira e
+ *     roda depois da leitura);
+ *   - as rotas são geradas em --threads threads, em ordem de ID;
+ *   - uma thread de escrita imprime cada agenda assim que ela e todas as
+ *     anteriores ficam prontas, e libera a sua memória.
+ *
+ * Só algumas agendas prontas esperam pela escrita ao mesmo tempo: uma rota
+ * só começa quando está a menos de AGENDAS_POR_THREAD · threads posições da
+ * próxima a ser escrita. A saída é idêntica à da execução em fases.
+ *
+ * No Round-Robin, todo avaliador recebe imóveis até o fim da entrada, então
+ * as rotas começam só depois da leitura; o ganho está na atribuição
+ * feita durante a leitura e na escrita, que começa com a primeira rota em
+ * vez de esperar todas. Se uma rota falhar, as agendas anteriores a ela já
+ * podem ter sido escritas.
+ */
+
+#ifndef ESTEIRA_H
+#define ESTEIRA_H
+
+#include "opcoes.h"
+
+/// Agendas prontas por thread que podem esperar pela escrita
+constexpr int AGENDAS_POR_THREAD = 4;
+
+/**
+ * @brief Agenda a base da entrada padrão (ou de --input) no modo esteira
+ * @param opcoes Opções da execução (threads, atribuição, rota, formato, --timings)
+ * @return 0 (erros são lançados)
+ * @throws std::runtime_error se a base for inválida, uma rota falhar ou a escrita falhar
+ */
+int executarEsteira(const Opcoes& opcoes);
+
+#endif
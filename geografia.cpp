@@ -0,0 +1,38 @@
+/**
+ * @file geografia.cpp
+ * @brief Implementação das funções geográficas
+ * 
+ * Este arquivo contém as conversões auxiliares para a esfera unitária; a
+ * fórmula de Haversine fica no cabeçalho, para ser expandida nos laços das
+ * rotas.
+ */
+
+#include "geografia.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Converte latitude/longitude em graus para um ponto da esfera unitária
+ * 
+ * Na esfera unitária a distância euclidiana (corda) cresce junto com a
+ * distância sobre a superfície, o que permite usar caixas envolventes
+ * em três dimensões para limitar inferiormente a distância de Haversine.
+ */
+void paraCartesiano(double lat, double lon, double xyz[3]) {
+    double latRad = lat * M_PI / 180.0;
+    double lonRad = lon * M_PI / 180.0;
+    double cosLat = std::cos(latRad);
+    xyz[0] = cosLat * std::cos(lonRad);
+    xyz[1] = cosLat * std::sin(lonRad);
+    xyz[2] = std::sin(latRad);
+}
+
+/**
+ * @brief Converte uma corda da esfera unitária na distância em km sobre a superfície
+ * 
+ * Usa a relação arco = 2 * asin(corda / 2), limitando o argumento a 1
+ * para tolerar erros de arredondamento em pontos antípodas.
+ */
+double cordaParaKm(double corda) {
+    return 2.0 * EARTH_R * std::asin(std::min(1.0, corda / 2.0));
+}
@@ -0,0 +1,57 @@
+/**
+ * @file geografia.h
+ * @brief Funções geográficas compartilhadas pelo sistema de agendamento
+ * 
+ * Reúne o cálculo de distância por Haversine e a conversão de coordenadas
+ * geográficas para pontos na esfera unitária, usada pelo índice espacial.
+ */
+
+#ifndef GEOGRAFIA_H
+#define GEOGRAFIA_H
+
+#include <cmath>
+#include "metricas.h"
+
+constexpr double EARTH_R = 6371.0; // Raio da Terra em km
+
+/**
+ * @brief Calcula a distância em km entre duas coordenadas geográficas
+ * usando a fórmula de Haversine
+ * @param lat1 Latitude do primeiro ponto
+ * @param lon1 Longitude do primeiro ponto
+ * @param lat2 Latitude do segundo ponto
+ * @param lon2 Longitude do segundo ponto
+ * @return Distância em quilômetros
+ *
+ * Implementação da fórmula conforme especificada no enunciado. Todo cálculo
+ * que decide a ordem das visitas passa por esta função, para que os
+ * horários gerados sejam reprodutíveis.
+ */
+inline double haversine(double lat1, double lon1, double lat2, double lon2) {
+    METRICA_CONTAR(haversine, 1);
+    auto deg2rad = [](double d){ return d * M_PI / 180.0; };
+    double dlat = deg2rad(lat2 - lat1);
+    double dlon = deg2rad(lon2 - lon1);
+    double a = std::pow(std::sin(dlat/2), 2) +
+               std::cos(deg2rad(lat1)) * std::cos(deg2rad(lat2)) *
+               std::pow(std::sin(dlon/2), 2);
+    double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+    return EARTH_R * c;
+}
+
+/**
+ * @brief Converte latitude/longitude em graus para um ponto da esfera unitária
+ * @param lat Latitude em graus
+ * @param lon Longitude em graus
+ * @param xyz Vetor de saída com as coordenadas cartesianas (x, y, z)
+ */
+void paraCartesiano(double lat, double lon, double xyz[3]);
+
+/**
+ * @brief Converte uma corda da esfera unitária na distância em km sobre a superfície
+ * @param corda Comprimento da corda (distância euclidiana entre pontos da esfera unitária)
+ * @return Distância do arco correspondente em quilômetros
+ */
+double cordaParaKm(double corda);
+
+#endif
@@ -0,0 +1,388 @@
+/**
+ * @file gerador.cpp
+ * @brief Gerador de entradas sintéticas no formato do programa
+ *
+ * Escreve na saída padrão uma entrada válida (corretores, clientes e
+ * imóveis) com quantidades e distribuição espacial configuráveis, para
+ * medir o comportamento do agendamento em escala:
+ *
+ *   - uniform: imóveis uniformes num quadrado em torno do centro;
+ *   - clustered: imóveis em aglomerados gaussianos de centros aleatórios;
+ *   - city: densidade decrescente a partir do centro, coordenadas presas a
+ *     uma malha de quadras (~100 m) e prédios com vários imóveis no mesmo
+ *     ponto.
+ *
+ * Com --rede-m M, escreve em vez da base uma malha viária (formato de
+ * rede_viaria.h) sobre o mesmo quadrado: ruas a cada M metros, nós com um
+ * pequeno deslocamento aleatório, custo de cada trecho entre 1,0 e 1,6 vez
+ * o comprimento (vias lentas) e 5% dos trechos removidos.
+ *
+ * A mesma semente gera sempre o mesmo arquivo (com a mesma biblioteca
+ * padrão: as distribuições de <random> podem variar entre implementações).
+ *
+ * Uso: gerador --imoveis N [--corretores N] [--avaliadores N] [--clientes N]
+ *              [--dist uniform|clustered|city] [--raio-km R] [--seed S]
+ *      gerador --rede-m M [--raio-km R] [--seed S]
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Centro padrão das bases geradas (Fortaleza, como nos testes)
+constexpr double LATITUDE_CENTRO = -3.75;
+constexpr double LONGITUDE_CENTRO = -38.55;
+constexpr double KM_POR_GRAU = 111.195;
+
+const char* const USO =
+    "Uso: gerador --imoveis N [--corretores N] [--avaliadores N] [--clientes N]\n"
+    "             [--dist uniform|clustered|city] [--raio-km R] [--seed S]\n"
+    "     gerador --rede-m M [--raio-km R] [--seed S]\n";
+
+enum class Distribuicao { Uniforme, Agrupada, Cidade };
+
+struct ParametrosGerador {
+    long long imoveis = 1000;
+    long long corretores = -1;  ///< Padrão: max(4, imoveis / 1000)
+    long long avaliadores = -1; ///< Padrão: 80% dos corretores
+    long long clientes = -1;    ///< Padrão: max(1, imoveis / 10)
+    Distribuicao distribuicao = Distribuicao::Uniforme;
+    double raioKm = 20.0;
+    unsigned long long semente = 42;
+    long long redeMetros = 0;   ///< Espaçamento da malha viária; 0 gera a base
+    bool ajuda = false;         ///< --help: só mostra o uso
+};
+
+long long inteiroNaoNegativo(const std::string& valor, const std::string& nome) {
+    size_t lidos = 0;
+    long long numero = -1;
+    try {
+        numero = std::stoll(valor, &lidos);
+    } catch (const std::exception&) {
+        lidos = 0;
+    }
+    if (lidos != valor.size() || numero < 0) {
+        throw std::runtime_error("Erro: valor inválido para " + nome + ": " + valor);
+    }
+    return numero;
+}
+
+ParametrosGerador lerParametros(int argc, char* argv[]) {
+    ParametrosGerador p;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // Opções sem valor antes das que pedem um
+        if (arg == "--help" || arg == "-h") {
+            p.ajuda = true;
+            return p;
+        }
+        std::string nome = arg.substr(0, arg.find('='));
+        std::string valor;
+        if (nome.size() < arg.size()) {
+            valor = arg.substr(nome.size() + 1);
+        } else if (i + 1 < argc) {
+            valor = argv[++i];
+        } else {
+            throw std::runtime_error("Erro: opção " + nome + " requer um valor");
+        }
+
+        if (nome == "--imoveis") {
+            p.imoveis = inteiroNaoNegativo(valor, nome);
+        } else if (nome == "--corretores") {
+            p.corretores = inteiroNaoNegativo(valor, nome);
+        } else if (nome == "--avaliadores") {
+            p.avaliadores = inteiroNaoNegativo(valor, nome);
+        } else if (nome == "--clientes") {
+            p.clientes = inteiroNaoNegativo(valor, nome);
+        } else if (nome == "--seed") {
+            p.semente = static_cast<unsigned long long>(inteiroNaoNegativo(valor, nome));
+        } else if (nome == "--rede-m") {
+            p.redeMetros = inteiroNaoNegativo(valor, nome);
+            if (p.redeMetros < 10) {
+                throw std::runtime_error("Erro: --rede-m deve ser de pelo menos 10 metros");
+            }
+        } else if (nome == "--raio-km") {
+            p.raioKm = std::stod(valor);
+            if (!(p.raioKm > 0.0 && p.raioKm <= 2000.0)) {
+                throw std::runtime_error("Erro: --raio-km deve estar entre 0 e 2000");
+            }
+        } else if (nome == "--dist") {
+            if (valor == "uniform") {
+                p.distribuicao = Distribuicao::Uniforme;
+            } else if (valor == "clustered") {
+                p.distribuicao = Distribuicao::Agrupada;
+            } else if (valor == "city") {
+                p.distribuicao = Distribuicao::Cidade;
+            } else {
+                throw std::runtime_error("Erro: valor inválido para --dist: " + valor + " (use uniform, clustered ou city)");
+            }
+        } else {
+            throw std::runtime_error("Erro: opção desconhecida: " + nome);
+        }
+    }
+
+    if (p.imoveis <= 0) {
+        throw std::runtime_error("Erro: --imoveis deve ser positivo");
+    }
+    if (p.corretores < 0) {
+        p.corretores = std::max(4LL, p.imoveis / 1000);
+    }
+    if (p.avaliadores < 0) {
+        p.avaliadores = std::max(1LL, p.corretores * 4 / 5);
+    }
+    if (p.clientes < 0) {
+        p.clientes = std::max(1LL, p.imoveis / 10);
+    }
+    if (p.corretores <= 0 || p.avaliadores <= 0 || p.avaliadores > p.corretores || p.clientes <= 0) {
+        throw std::runtime_error("Erro: é preciso ao menos um corretor avaliador e um cliente (avaliadores <= corretores)");
+    }
+    return p;
+}
+
+/**
+ * Saída em blocos grandes com fwrite, sem formatação de stream
+ */
+class Escritor {
+public:
+    ~Escritor() { descarregar(); }
+
+    void texto(const char* s) { buffer += s; verificar(); }
+    void texto(const std::string& s) { buffer += s; verificar(); }
+    void inteiro(long long v) { buffer += std::to_string(v); verificar(); }
+    void real(double v, int casas) {
+        char tmp[32];
+        std::snprintf(tmp, sizeof(tmp), "%.*f", casas, v);
+        buffer += tmp;
+        verificar();
+    }
+    void descarregar() {
+        std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+        buffer.clear();
+    }
+
+private:
+    std::string buffer;
+    void verificar() {
+        if (buffer.size() > (1u << 20)) {
+            descarregar();
+        }
+    }
+};
+
+/**
+ * Sorteia as coordenadas de um ponto segundo a distribuição escolhida
+ */
+class Sorteador {
+public:
+    Sorteador(const ParametrosGerador& p, std::mt19937_64& gerador)
+        : p(p), gerador(gerador) {
+        // Graus por km nas duas direções (longitude encolhe com cos(lat))
+        grauLat = 1.0 / KM_POR_GRAU;
+        grauLon = 1.0 / (KM_POR_GRAU * std::cos(LATITUDE_CENTRO * M_PI / 180.0));
+        if (p.distribuicao == Distribuicao::Agrupada) {
+            long long numAglomerados = std::max(4LL, std::min(1000LL, p.imoveis / 500));
+            for (long long i = 0; i < numAglomerados; ++i) {
+                double x, y;
+                uniforme(x, y);
+                centros.push_back({x, y});
+            }
+        }
+    }
+
+    /// Deslocamento (km) a partir do centro
+    void imovel(double& xKm, double& yKm) {
+        switch (p.distribuicao) {
+            case Distribuicao::Uniforme:
+                uniforme(xKm, yKm);
+                break;
+            case Distribuicao::Agrupada: {
+                const auto& c = centros[std::uniform_int_distribution<size_t>(0, centros.size() - 1)(gerador)];
+                std::normal_distribution<double> espalhamento(0.0, p.raioKm / 40.0);
+                xKm = c[0] + espalhamento(gerador);
+                yKm = c[1] + espalhamento(gerador);
+                break;
+            }
+            case Distribuicao::Cidade: {
+                // Prédio: vários imóveis no mesmo ponto
+                if (!anteriores.empty() && std::uniform_real_distribution<double>(0.0, 1.0)(gerador) < 0.15) {
+                    const auto& a = anteriores[std::uniform_int_distribution<size_t>(0, anteriores.size() - 1)(gerador)];
+                    xKm = a[0];
+                    yKm = a[1];
+                    return;
+                }
+                // Densidade exponencial a partir do centro, presa à malha de quadras
+                double r = std::exponential_distribution<double>(3.0 / p.raioKm)(gerador);
+                double angulo = std::uniform_real_distribution<double>(0.0, 2 * M_PI)(gerador);
+                r = std::min(r, p.raioKm);
+                xKm = std::round(r * std::cos(angulo) * 10.0) / 10.0;
+                yKm = std::round(r * std::sin(angulo) * 10.0) / 10.0;
+                if (anteriores.size() < 100000) {
+                    anteriores.push_back({xKm, yKm});
+                }
+                break;
+            }
+        }
+    }
+
+    void uniforme(double& xKm, double& yKm) {
+        std::uniform_real_distribution<double> faixa(-p.raioKm, p.raioKm);
+        xKm = faixa(gerador);
+        yKm = faixa(gerador);
+    }
+
+    double latitude(double yKm) const { return LATITUDE_CENTRO + yKm * grauLat; }
+    double longitude(double xKm) const { return LONGITUDE_CENTRO + xKm * grauLon; }
+
+private:
+    const ParametrosGerador& p;
+    std::mt19937_64& gerador;
+    double grauLat, grauLon;
+    std::vector<std::array<double, 2>> centros;
+    std::vector<std::array<double, 2>> anteriores;
+};
+
+/**
+ * Malha viária em grade sobre o quadrado da base
+ */
+void escreverRede(const ParametrosGerador& p, std::mt19937_64& gerador, Sorteador& sorteador, Escritor& saida) {
+    double passoKm = p.redeMetros / 1000.0;
+    long long lado = static_cast<long long>(2.0 * p.raioKm / passoKm) + 1;
+    if (lado * lado > 50000000LL) {
+        throw std::runtime_error("Erro: malha grande demais; aumente --rede-m");
+    }
+    std::uniform_real_distribution<double> deslocamento(-0.15 * passoKm, 0.15 * passoKm);
+    std::uniform_real_distribution<double> lentidao(1.0, 1.6);
+    std::uniform_real_distribution<double> sorteio(0.0, 1.0);
+
+    saida.texto("# Malha viária sintética: ");
+    saida.inteiro(lado * lado);
+    saida.texto(" nós, ruas a cada ");
+    saida.inteiro(p.redeMetros);
+    saida.texto(" m\n");
+    std::vector<double> x(lado * lado), y(lado * lado);
+    for (long long i = 0; i < lado; ++i) {
+        for (long long j = 0; j < lado; ++j) {
+            long long no = i * lado + j;
+            x[no] = -p.raioKm + j * passoKm + deslocamento(gerador);
+            y[no] = -p.raioKm + i * passoKm + deslocamento(gerador);
+            saida.texto("v ");
+            saida.inteiro(no + 1);
+            saida.texto(" ");
+            saida.real(sorteador.latitude(y[no]), 6);
+            saida.texto(" ");
+            saida.real(sorteador.longitude(x[no]), 6);
+            saida.texto("\n");
+        }
+    }
+    auto trecho = [&](long long a, long long b) {
+        if (sorteio(gerador) < 0.05) {
+            return;
+        }
+        double km = std::hypot(x[a] - x[b], y[a] - y[b]) * lentidao(gerador);
+        saida.texto("e ");
+        saida.inteiro(a + 1);
+        saida.texto(" ");
+        saida.inteiro(b + 1);
+        saida.texto(" ");
+        saida.real(km, 4);
+        saida.texto("\n");
+    };
+    for (long long i = 0; i < lado; ++i) {
+        for (long long j = 0; j < lado; ++j) {
+            if (j + 1 < lado) {
+                trecho(i * lado + j, i * lado + j + 1);
+            }
+            if (i + 1 < lado) {
+                trecho(i * lado + j, (i + 1) * lado + j);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        ParametrosGerador p = lerParametros(argc, argv);
+        if (p.ajuda) {
+            std::cout << USO;
+            return 0;
+        }
+        std::mt19937_64 gerador(p.semente);
+        Sorteador sorteador(p, gerador);
+        Escritor saida;
+        if (p.redeMetros > 0) {
+            escreverRede(p, gerador, sorteador, saida);
+            return 0;
+        }
+
+        // Corretores: os avaliadores são espalhados entre os não avaliadores
+        saida.inteiro(p.corretores);
+        saida.texto("\n");
+        for (long long i = 0; i < p.corretores; ++i) {
+            bool avaliador = (i * p.avaliadores) / p.corretores != ((i + 1) * p.avaliadores) / p.corretores;
+            double x, y;
+            sorteador.uniforme(x, y);
+            saida.texto("9");
+            saida.inteiro(100000000 + i);
+            saida.texto(avaliador ? " 1 " : " 0 ");
+            saida.real(sorteador.latitude(y * 0.8), 6);
+            saida.texto(" ");
+            saida.real(sorteador.longitude(x * 0.8), 6);
+            saida.texto(" Corretor ");
+            saida.inteiro(i + 1);
+            saida.texto("\n");
+        }
+
+        saida.texto("\n");
+        saida.inteiro(p.clientes);
+        saida.texto("\n");
+        for (long long i = 0; i < p.clientes; ++i) {
+            saida.texto("8");
+            saida.inteiro(500000000 + i);
+            saida.texto(" Cliente ");
+            saida.inteiro(i + 1);
+            saida.texto("\n");
+        }
+
+        static const char* const TIPOS[] = {"Casa", "Apartamento", "Terreno"};
+        std::uniform_int_distribution<int> tipo(0, 2);
+        std::uniform_int_distribution<long long> proprietario(1, p.clientes);
+        std::uniform_int_distribution<int> preco(50, 2000);
+        std::uniform_int_distribution<int> numero(1, 3000);
+
+        saida.texto("\n");
+        saida.inteiro(p.imoveis);
+        saida.texto("\n");
+        for (long long i = 0; i < p.imoveis; ++i) {
+            double x = 0.0, y = 0.0;
+            sorteador.imovel(x, y);
+            saida.texto(TIPOS[tipo(gerador)]);
+            saida.texto(" ");
+            saida.inteiro(proprietario(gerador));
+            saida.texto(" ");
+            saida.real(sorteador.latitude(y), 6);
+            saida.texto(" ");
+            saida.real(sorteador.longitude(x), 6);
+            saida.texto(" ");
+            saida.inteiro(preco(gerador) * 1000LL);
+            saida.texto(".0 Rua ");
+            saida.inteiro(i % 997 + 1);
+            saida.texto(", ");
+            saida.inteiro(numero(gerador));
+            saida.texto("\n");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
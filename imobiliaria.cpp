@@ -0,0 +1,87 @@
+/**
+ * @file imobiliaria.cpp
+ * @brief Implementação da API da biblioteca libimobiliaria
+ *
+ * Repete as etapas do programa (seleção dos avaliadores, distribuição e
+ * rotas) sobre cópias locais da base, sem ler a entrada padrão nem
+ * escrever na saída de erro.
+ */
+
+#include "imobiliaria.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * Mesmos intervalos da leitura da entrada (dados.cpp); a negação também
+ * rejeita NaN
+ */
+bool coordenadaValida(double lat, double lon) {
+    return lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0;
+}
+
+} // namespace
+
+inline namespace IMOBILIARIA_NAMESPACE_COORDENADAS {
+
+/**
+ * @brief Gera as agendas de uma base em memória
+ */
+std::vector<AgendaCorretor> agendarAvaliacoes(const Corretor* corretores, std::size_t numCorretores,
+                                              const Imovel* imoveis, std::size_t numImoveis,
+                                              const ParametrosAgenda& parametros) {
+    const std::size_t limite = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    if (numCorretores > limite || numImoveis > limite) {
+        throw std::runtime_error("Erro: base grande demais para IDs de 32 bits");
+    }
+
+    // Cópias numeradas pela posição: as rotas indexam os imóveis pelo ID
+    std::vector<Corretor> base;
+    base.reserve(numCorretores);
+    for (std::size_t i = 0; i < numCorretores; ++i) {
+        const Corretor& c = corretores[i];
+        if (!coordenadaValida(c.latitude, c.longitude)) {
+            throw std::runtime_error("Erro: corretor " + std::to_string(i + 1) + ": coordenadas inválidas");
+        }
+        base.emplace_back(static_cast<int>(i + 1), c.telefone, c.avaliador, c.latitude, c.longitude, c.nome);
+    }
+    std::vector<Imovel> locais;
+    locais.reserve(numImoveis);
+    for (std::size_t i = 0; i < numImoveis; ++i) {
+        const Imovel& m = imoveis[i];
+        if (!coordenadaValida(m.latitude, m.longitude)) {
+            throw std::runtime_error("Erro: imóvel " + std::to_string(i + 1) + ": coordenadas inválidas");
+        }
+        if (m.tipo != Casa && m.tipo != Apartamento && m.tipo != Terreno) {
+            throw std::runtime_error("Erro: imóvel " + std::to_string(i + 1) + ": tipo inválido");
+        }
+        locais.emplace_back(static_cast<int>(i + 1), m.tipo, m.proprietarioId, m.latitude, m.longitude,
+                            m.preco, m.endereco);
+    }
+
+    std::vector<const Corretor*> avaliadores = selecionarAvaliadores(base, locais);
+    Atribuicao atribuicao = atribuirImoveis(locais, avaliadores, parametros.atribuicao, parametros.threads);
+
+    std::vector<AgendaCorretor> agendas;
+    std::vector<int> comImoveis;
+    for (int k = 0; k < atribuicao.numAvaliadores(); ++k) {
+        if (!atribuicao.imoveisDe(k).vazia()) {
+            agendas.push_back({atribuicao.avaliadores[k]->id, {}});
+            comImoveis.push_back(k);
+        }
+    }
+    ConfiguracaoRota rota = parametros.rota;
+    rota.threadsExato = std::max(1, parametros.threads / std::max(1, static_cast<int>(agendas.size())));
+    executarEmParalelo(static_cast<int>(agendas.size()), parametros.threads, [&](int i) {
+        int k = comImoveis[i];
+        agendas[i].visitas = gerarAgendamentoCorretor(locais, *atribuicao.avaliadores[k], atribuicao.imoveisDe(k),
+                                                      rota);
+    });
+    return agendas;
+}
+
+} // namespace IMOBILIARIA_NAMESPACE_COORDENADAS
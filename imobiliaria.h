@@ -0,0 +1,80 @@
+/**
+ * @file imobiliaria.h
+ * @brief API da biblioteca libimobiliaria: agendamento a partir de dados em memória
+ *
+ * Permite gerar as agendas sem executar o programa: quem chama entrega os
+ * corretores e os imóveis já em memória e recebe as visitas de cada
+ * avaliador, as mesmas que o programa imprimiria para essa base com as
+ * mesmas opções.
+ *
+ * A biblioteca não tem estado global: cada chamada trabalha só sobre os
+ * dados recebidos e sobre cópias próprias, então várias threads podem
+ * chamar agendarAvaliacoes ao mesmo tempo, com bases iguais ou diferentes.
+ * A única memória compartilhada entre chamadas é a malha viária de
+ * ParametrosAgenda::rota.rede, que é apenas lida.
+ *
+ * Compilação: "make lib" gera libimobiliaria.a e libimobiliaria.so.
+ *
+ * Quem usa a biblioteca deve compilar com as mesmas COORDENADAS_FLAGS dela:
+ * -DIMOBILIARIA_COORDENADAS_FLOAT muda o layout de Imovel. Por isso a função
+ * fica num namespace inline que depende dessa opção, e um programa compilado
+ * com a outra falha na ligação em vez de ler os imóveis com o layout errado.
+ */
+
+#ifndef IMOBILIARIA_H
+#define IMOBILIARIA_H
+
+#include <cstddef>
+#include <vector>
+#include "agendamento.h"
+#include "atribuicao.h"
+#include "corretor.h"
+#include "imovel.h"
+
+#ifdef IMOBILIARIA_COORDENADAS_FLOAT
+#define IMOBILIARIA_NAMESPACE_COORDENADAS coordenadas_float
+#else
+#define IMOBILIARIA_NAMESPACE_COORDENADAS coordenadas_double
+#endif
+
+/**
+ * @struct ParametrosAgenda
+ * @brief Opções de uma chamada (as mesmas da linha de comando)
+ */
+struct ParametrosAgenda {
+    ModoAtribuicao atribuicao = ModoAtribuicao::RoundRobin; ///< Distribuição dos imóveis (--assign)
+    ConfiguracaoRota rota; ///< Melhoria, distância, malha viária e tempo das visitas
+    int threads = 1;       ///< Threads usadas pelas rotas desta chamada (--threads)
+};
+
+/**
+ * @struct AgendaCorretor
+ * @brief Visitas de um avaliador, em ordem de horário
+ */
+struct AgendaCorretor {
+    int corretorId; ///< Posição do corretor na entrada, a partir de 1
+    std::vector<Agendamento> visitas; ///< imovelId é a posição do imóvel na entrada, a partir de 1
+};
+
+/**
+ * @brief Gera as agendas de uma base em memória
+ *
+ * Os IDs seguem a posição de cada elemento (corretores[0] é o corretor 1,
+ * imoveis[0] é o imóvel 1), como na leitura da entrada; o campo id
+ * recebido é ignorado. Os dados recebidos não são alterados e não precisam
+ * durar além da chamada.
+ *
+ * @param corretores Corretores da base (numCorretores elementos)
+ * @param imoveis Imóveis da base (numImoveis elementos)
+ * @param parametros Opções da geração
+ * @return Agenda de cada avaliador com imóveis, em ordem de ID
+ * @throws std::runtime_error se alguma coordenada for inválida, se não houver
+ *         avaliadores ou imóveis, ou se a rota não puder ser gerada
+ */
+inline namespace IMOBILIARIA_NAMESPACE_COORDENADAS {
+std::vector<AgendaCorretor> agendarAvaliacoes(const Corretor* corretores, std::size_t numCorretores,
+                                              const Imovel* imoveis, std::size_t numImoveis,
+                                              const ParametrosAgenda& parametros = ParametrosAgenda());
+}
+
+#endif
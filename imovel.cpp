@@ -8,15 +8,12 @@
 
 #include "imovel.h"
 
-// Inicialização do contador estático de IDs
-int Imovel::nextId = 1;
-
 /**
  * @brief Construtor da classe Imovel
  * 
- * Inicializa um novo imóvel com as informações fornecidas e
- * atribui automaticamente um ID único sequencial.
+ * Inicializa um novo imóvel com as informações fornecidas.
  * 
+ * @param id ID do imóvel
  * @param tipo Tipo do imóvel (Casa, Apartamento, Terreno)
  * @param propId ID do cliente proprietário do imóvel
  * @param lat Latitude da localização do imóvel
@@ -24,8 +21,8 @@ int Imovel::nextId = 1;
  * @param preco Preço do imóvel
  * @param endereco Endereço completo do imóvel
  */
-Imovel::Imovel(TipoImovel tipo, int propId, double lat, double lon, double preco, const std::string& endereco)
-    : id(nextId++), tipo(tipo), proprietarioId(propId), latitude(lat), longitude(lon), endereco(endereco), preco(preco) {
+Imovel::Imovel(int id, TipoImovel tipo, int propId, double lat, double lon, double preco, std::string_view endereco)
+    : latitude(lat), longitude(lon), preco(preco), endereco(endereco), id(id), proprietarioId(propId), tipo(tipo) {
 }
 
 /**
@@ -39,7 +36,7 @@ Imovel::Imovel(TipoImovel tipo, int propId, double lat, double lon, double preco
  * @return TipoImovel correspondente à string fornecida
  * @note Se a string não for reconhecida, retorna Casa como padrão
  */
-TipoImovel Imovel::stringToTipo(const std::string& tipoStr) {
+TipoImovel Imovel::stringToTipo(std::string_view tipoStr) {
     if (tipoStr == "Casa") {
         return Casa;
     } else if (tipoStr == "Apartamento") {
@@ -9,18 +9,33 @@
 #ifndef IMOVEL_H
 #define IMOVEL_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 /**
  * @enum TipoImovel
  * @brief Enumeração dos tipos de imóveis disponíveis no sistema
  */
-enum TipoImovel {
+enum TipoImovel : std::uint8_t {
     Casa,        ///< Casa residencial
     Apartamento, ///< Apartamento
     Terreno      ///< Terreno
 };
 
+/**
+ * Tipo das coordenadas guardadas em Imovel. Compilando com
+ * -DIMOBILIARIA_COORDENADAS_FLOAT ("make COORDENADAS_FLAGS=..."), elas passam
+ * a ocupar 4 bytes cada e o imóvel cai de 56 para 48 bytes; os cálculos
+ * continuam em double, mas partem das coordenadas arredondadas (erro de até
+ * ~1 m), então a saída pode diferir da especificada.
+ */
+#ifdef IMOBILIARIA_COORDENADAS_FLOAT
+using CoordenadaImovel = float;
+#else
+using CoordenadaImovel = double;
+#endif
+
 /**
  * @class Imovel
  * @brief Representa um imóvel no sistema de agendamento
@@ -28,30 +43,33 @@ enum TipoImovel {
  * Um imóvel possui informações sobre seu tipo, localização geográfica,
  * proprietário, endereço e preço. Estas informações são utilizadas
  * para calcular rotas otimizadas e gerar agendamentos.
+ * 
+ * O endereço é uma view de um texto guardado numa ArenaTextos (textos.h),
+ * que precisa durar tanto quanto o imóvel. Os campos estão ordenados por
+ * tamanho, com as coordenadas no início (56 bytes por imóvel, 48 com
+ * coordenadas float). O ID é de 32 bits, como o índice das rotas.
  */
 class Imovel {
-private:
-    static int nextId; ///< Contador estático para gerar IDs únicos
-    
 public:
-    int id;                    ///< ID único do imóvel (auto-incremento)
-    TipoImovel tipo;           ///< Tipo do imóvel (Casa, Apartamento, Terreno)
-    int proprietarioId;        ///< ID do cliente proprietário do imóvel
-    double latitude;           ///< Latitude da localização do imóvel
-    double longitude;          ///< Longitude da localização do imóvel
-    std::string endereco;      ///< Endereço completo do imóvel
-    double preco;              ///< Preço do imóvel
+    CoordenadaImovel latitude;  ///< Latitude da localização do imóvel
+    CoordenadaImovel longitude; ///< Longitude da localização do imóvel
+    double preco;               ///< Preço do imóvel
+    std::string_view endereco;  ///< Endereço completo do imóvel (na arena de textos)
+    int id;                     ///< ID do imóvel (posição na base, a partir de 1)
+    int proprietarioId;         ///< ID do cliente proprietário do imóvel
+    TipoImovel tipo;            ///< Tipo do imóvel (Casa, Apartamento, Terreno)
     
     /**
      * @brief Construtor da classe Imovel
+     * @param id ID do imóvel (quem lê a base numera 1, 2, ...)
      * @param tipo Tipo do imóvel
      * @param propId ID do proprietário
      * @param lat Latitude da localização
      * @param lon Longitude da localização
      * @param preco Preço do imóvel
-     * @param endereco Endereço completo
+     * @param endereco Endereço completo (não é copiado; deve durar tanto quanto o imóvel)
      */
-    Imovel(TipoImovel tipo, int propId, double lat, double lon, double preco, const std::string& endereco);
+    Imovel(int id, TipoImovel tipo, int propId, double lat, double lon, double preco, std::string_view endereco);
     
     /**
      * @brief Converte uma string para o tipo de imóvel correspondente
@@ -59,7 +77,7 @@ public:
      * @return TipoImovel correspondente à string
      * @note Retorna Casa como padrão se a string não for reconhecida
      */
-    static TipoImovel stringToTipo(const std::string& tipoStr);
+    static TipoImovel stringToTipo(std::string_view tipoStr);
 };
 
 #endif 
\ No newline at end of file
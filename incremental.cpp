@@ -0,0 +1,299 @@
+/**
+ * @file incremental.cpp
+ * @brief Implementação da manutenção incremental das rotas
+ */
+
+#include "incremental.h"
+#include "geografia.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+/// Imóveis mais próximos do novo ponto cujos vizinhos de rota são testados
+constexpr int VIZINHOS_INSERCAO = 16;
+
+/// Tamanho mínimo da lista de inseridos antes de reconstruir o índice
+constexpr int MINIMO_EXTRAS = 1024;
+
+} // namespace
+
+/**
+ * @brief Assume a base com as rotas já geradas
+ */
+AgendaIncremental::AgendaIncremental(std::vector<Corretor> corretoresIniciais,
+                                     std::vector<std::vector<int>> rotasIniciais,
+                                     std::vector<Imovel> imoveisIniciais,
+                                     ArenaTextos textosIniciais,
+                                     const ConfiguracaoRota& configuracaoRota)
+    : corretores(std::move(corretoresIniciais)),
+      rotas(std::move(rotasIniciais)),
+      imoveis(std::move(imoveisIniciais)),
+      textos(std::move(textosIniciais)),
+      configuracao(configuracaoRota),
+      donoDoImovel(imoveis.size(), -1),
+      posicaoNaRota(imoveis.size(), -1) {
+    for (size_t c = 0; c < corretores.size(); ++c) {
+        if (corretores[c].isAvaliador()) {
+            ++numAvaliadores;
+        }
+        const std::vector<int>& rota = rotas[c];
+        trechos.emplace_back();
+        trechos.back().reserve(rota.size());
+        for (size_t i = 0; i < rota.size(); ++i) {
+            donoDoImovel[rota[i] - 1] = static_cast<int>(c);
+            posicaoNaRota[rota[i] - 1] = static_cast<int>(i);
+            const Imovel& imovel = imoveis[rota[i] - 1];
+            trechos.back().push_back(distanciaAte(static_cast<int>(c), static_cast<int>(i),
+                                                  imovel.latitude, imovel.longitude));
+        }
+        numAgendados += static_cast<int>(rota.size());
+    }
+    reconstruirIndice();
+}
+
+/**
+ * Reconstrói o índice espacial com todos os imóveis agendados e esvazia a
+ * lista de inseridos
+ */
+void AgendaIncremental::reconstruirIndice() {
+    BlocoCoordenadas pontos;
+    pontos.reservar(numAgendados);
+    imovelDoIndice.clear();
+    imovelDoIndice.reserve(numAgendados);
+    posicaoNoIndice.assign(imoveis.size(), -1);
+    for (const Imovel& imovel : imoveis) {
+        if (donoDoImovel[imovel.id - 1] >= 0) {
+            posicaoNoIndice[imovel.id - 1] = static_cast<int>(imovelDoIndice.size());
+            imovelDoIndice.push_back(imovel.id);
+            pontos.adicionar(imovel.latitude, imovel.longitude);
+        }
+    }
+    indice = imovelDoIndice.empty() ? nullptr : std::make_unique<IndiceEspacial>(pontos);
+
+    extras = BlocoCoordenadas();
+    imovelDoExtra.clear();
+    extraDoImovel.assign(imoveis.size(), -1);
+}
+
+/**
+ * Reúne os k imóveis agendados mais próximos, do índice e da lista de inseridos
+ */
+void AgendaIncremental::vizinhosProximos(double lat, double lon, int k, std::vector<int>& ids) const {
+    std::vector<std::pair<double, int>> candidatos;
+    if (indice) {
+        std::vector<int> posicoes;
+        std::vector<double> distancias;
+        indice->kMaisProximos(lat, lon, k, posicoes, distancias);
+        for (size_t i = 0; i < posicoes.size(); ++i) {
+            candidatos.emplace_back(distancias[i], imovelDoIndice[posicoes[i]]);
+        }
+    }
+    int numExtras = static_cast<int>(extras.tamanho());
+    if (numExtras > 0) {
+        double origem[3];
+        paraCartesiano(lat, lon, origem);
+        std::vector<double> cordas(numExtras);
+        cordasQuadradasLote(extras, 0, numExtras, origem, cordas.data());
+        for (int j = 0; j < numExtras; ++j) {
+            if (imovelDoExtra[j] >= 0) {
+                candidatos.emplace_back(cordaParaKm(std::sqrt(cordas[j])), imovelDoExtra[j]);
+            }
+        }
+    }
+    size_t quantos = std::min(candidatos.size(), static_cast<size_t>(k));
+    std::partial_sort(candidatos.begin(), candidatos.begin() + quantos, candidatos.end());
+    ids.clear();
+    for (size_t i = 0; i < quantos; ++i) {
+        ids.push_back(candidatos[i].second);
+    }
+}
+
+/**
+ * Atualiza posicaoNaRota a partir de uma posição da rota alterada
+ */
+void AgendaIncremental::renumerar(const std::vector<int>& rota, int aPartirDe) {
+    for (int i = aPartirDe; i < static_cast<int>(rota.size()); ++i) {
+        posicaoNaRota[rota[i] - 1] = i;
+    }
+}
+
+/**
+ * Distância da visita anterior à posição dada (ou do corretor, na posição 0) até o ponto
+ */
+double AgendaIncremental::distanciaAte(int c, int posicao, double lat, double lon) const {
+    const Corretor& corretor = corretores[c];
+    if (posicao == 0) {
+        return distanciaEntre(configuracao.distancia, corretor.latitude, corretor.longitude, lat, lon);
+    }
+    const Imovel& anterior = imoveis[rotas[c][posicao - 1] - 1];
+    return distanciaEntre(configuracao.distancia, anterior.latitude, anterior.longitude, lat, lon);
+}
+
+/**
+ * @brief Cadastra um imóvel e o insere na rota mais barata
+ *
+ * Inserir o imóvel x entre a e b custa d(a, x) + d(x, b) - d(a, b); no fim
+ * da rota (caminho aberto) custa apenas d(último, x). Empates vão para o
+ * corretor de menor ID e, nele, para a menor posição.
+ */
+int AgendaIncremental::adicionarImovel(Imovel imovel) {
+    if (numAvaliadores == 0) {
+        throw std::runtime_error("Erro: não há corretores avaliadores");
+    }
+    imovel.id = static_cast<int>(imoveis.size()) + 1;
+    imoveis.push_back(std::move(imovel));
+    donoDoImovel.push_back(-1);
+    posicaoNaRota.push_back(-1);
+    posicaoNoIndice.push_back(-1);
+    extraDoImovel.push_back(-1);
+    const Imovel& novo = imoveis.back();
+
+    // Cota da distribuição Round-Robin já contando o novo imóvel
+    int cota = (numAgendados + 1 + numAvaliadores - 1) / numAvaliadores;
+    auto elegivel = [&](int c) {
+        return corretores[c].isAvaliador() && static_cast<int>(rotas[c].size()) < cota;
+    };
+
+    // Melhor inserção: (custo, corretor, posição)
+    std::tuple<double, int, int> melhor(std::numeric_limits<double>::max(), -1, -1);
+    auto avaliar = [&](int c, int posicao) {
+        const std::vector<int>& rota = rotas[c];
+        double custo = distanciaAte(c, posicao, novo.latitude, novo.longitude);
+        if (posicao < static_cast<int>(rota.size())) {
+            const Imovel& seguinte = imoveis[rota[posicao] - 1];
+            custo += distanciaEntre(configuracao.distancia, novo.latitude, novo.longitude,
+                                    seguinte.latitude, seguinte.longitude) -
+                     trechos[c][posicao];
+        }
+        melhor = std::min(melhor, std::make_tuple(custo, c, posicao));
+    };
+
+    for (int c = 0; c < static_cast<int>(corretores.size()); ++c) {
+        if (elegivel(c)) {
+            avaliar(c, 0);
+            avaliar(c, static_cast<int>(rotas[c].size()));
+        }
+    }
+    std::vector<int> vizinhos;
+    vizinhosProximos(novo.latitude, novo.longitude, VIZINHOS_INSERCAO, vizinhos);
+    for (int vizinho : vizinhos) {
+        int c = donoDoImovel[vizinho - 1];
+        if (elegivel(c)) {
+            avaliar(c, posicaoNaRota[vizinho - 1]);
+            avaliar(c, posicaoNaRota[vizinho - 1] + 1);
+        }
+    }
+
+    auto [custo, c, posicao] = melhor;
+    (void)custo;
+    std::vector<int>& rota = rotas[c];
+    std::vector<double>& trechosRota = trechos[c];
+    trechosRota.insert(trechosRota.begin() + posicao, distanciaAte(c, posicao, novo.latitude, novo.longitude));
+    rota.insert(rota.begin() + posicao, novo.id);
+    if (posicao + 1 < static_cast<int>(rota.size())) {
+        const Imovel& seguinte = imoveis[rota[posicao + 1] - 1];
+        trechosRota[posicao + 1] = distanciaAte(c, posicao + 1, seguinte.latitude, seguinte.longitude);
+    }
+    renumerar(rota, posicao);
+    donoDoImovel[novo.id - 1] = c;
+    ++numAgendados;
+
+    extraDoImovel[novo.id - 1] = static_cast<int>(imovelDoExtra.size());
+    imovelDoExtra.push_back(novo.id);
+    extras.adicionar(novo.latitude, novo.longitude);
+    if (static_cast<int>(extras.tamanho()) > std::max(MINIMO_EXTRAS, numAgendados / 32)) {
+        reconstruirIndice();
+    }
+    return corretores[c].id;
+}
+
+/**
+ * @brief Retira um imóvel da rota em que está
+ *
+ * O antecessor passa a ligar direto no sucessor; as demais visitas mantêm
+ * a ordem.
+ */
+int AgendaIncremental::removerImovel(int imovelId) {
+    if (imovelId <= 0 || imovelId > static_cast<int>(imoveis.size()) || donoDoImovel[imovelId - 1] < 0) {
+        throw std::runtime_error("Erro: imóvel " + std::to_string(imovelId) + " não está agendado");
+    }
+    int c = donoDoImovel[imovelId - 1];
+    int posicao = posicaoNaRota[imovelId - 1];
+    std::vector<int>& rota = rotas[c];
+    rota.erase(rota.begin() + posicao);
+    trechos[c].erase(trechos[c].begin() + posicao);
+    if (posicao < static_cast<int>(rota.size())) {
+        const Imovel& seguinte = imoveis[rota[posicao] - 1];
+        trechos[c][posicao] = distanciaAte(c, posicao, seguinte.latitude, seguinte.longitude);
+    }
+    renumerar(rota, posicao);
+    donoDoImovel[imovelId - 1] = -1;
+    posicaoNaRota[imovelId - 1] = -1;
+    --numAgendados;
+
+    if (posicaoNoIndice[imovelId - 1] >= 0) {
+        indice->remover(posicaoNoIndice[imovelId - 1]);
+        posicaoNoIndice[imovelId - 1] = -1;
+    } else {
+        imovelDoExtra[extraDoImovel[imovelId - 1]] = -1;
+        extraDoImovel[imovelId - 1] = -1;
+    }
+    return corretores[c].id;
+}
+
+/**
+ * @brief Cadastra um corretor (com rota vazia)
+ */
+int AgendaIncremental::adicionarCorretor(Corretor corretor) {
+    corretor.id = static_cast<int>(corretores.size()) + 1;
+    if (corretor.isAvaliador()) {
+        ++numAvaliadores;
+    }
+    corretores.push_back(std::move(corretor));
+    rotas.emplace_back();
+    trechos.emplace_back();
+    return corretores.back().id;
+}
+
+/**
+ * @brief Calcula os horários da rota atual de um corretor
+ *
+ * Mesma regra de calcularAgendamentos, usando os trechos guardados.
+ */
+std::vector<Agendamento> AgendaIncremental::agenda(int corretorId) const {
+    if (corretorId <= 0 || corretorId > static_cast<int>(corretores.size())) {
+        throw std::runtime_error("Erro: corretor " + std::to_string(corretorId) + " não existe");
+    }
+    const std::vector<int>& rota = rotas[corretorId - 1];
+    const std::vector<double>& trechosRota = trechos[corretorId - 1];
+
+    std::vector<Agendamento> agendamentos;
+    agendamentos.reserve(rota.size());
+    int tempoAtual = 0; // minutos desde 09:00
+    for (size_t i = 0; i < rota.size(); ++i) {
+        tempoAtual += TempoFixo::deslocamento(trechosRota[i]);
+        auto [hora, minuto] = minutosParaHoraMinuto(tempoAtual);
+        agendamentos.emplace_back(hora, minuto, rota[i]);
+        tempoAtual += duracaoAvaliacao(configuracao.tempo, imoveis[rota[i] - 1].tipo);
+    }
+    return agendamentos;
+}
+
+/**
+ * @brief Distância total (km) percorrida por todos os corretores
+ */
+double AgendaIncremental::distanciaTotal() const {
+    double total = 0.0;
+    for (const std::vector<double>& trechosRota : trechos) {
+        for (double trecho : trechosRota) {
+            total += trecho;
+        }
+    }
+    return total;
+}
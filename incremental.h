@@ -0,0 +1,122 @@
+/**
+ * @file incremental.h
+ * @brief Manutenção incremental das rotas (modo serviço)
+ *
+ * Depois da geração completa, as rotas são mantidas por inserção mais
+ * barata e remoção simples, sem refazer a atribuição nem o vizinho mais
+ * próximo. Cada atualização altera a rota de um único corretor.
+ */
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <memory>
+#include <vector>
+#include "agendamento.h"
+#include "coordenadas.h"
+#include "corretor.h"
+#include "imovel.h"
+#include "indice_espacial.h"
+#include "textos.h"
+
+/**
+ * @class AgendaIncremental
+ * @brief Rotas de todos os corretores, atualizáveis imóvel a imóvel
+ *
+ * A rota de cada corretor é uma lista de IDs de imóveis, na ordem de
+ * visita. Um novo imóvel vai para a posição de menor acréscimo de distância
+ * entre os corretores que ainda estão abaixo da cota ⌈imóveis/avaliadores⌉
+ * (a mesma da distribuição Round-Robin). As posições candidatas são o início
+ * e o fim de cada rota elegível e os vizinhos, na rota, dos imóveis mais
+ * próximos do novo ponto; assim cada inserção custa O(log n) consultas mais
+ * o deslocamento da rota alterada.
+ *
+ * As distâncias de cada trecho ficam guardadas, então uma atualização
+ * recalcula só os dois ou três trechos que mudaram e a agenda é refeita
+ * sem novas distâncias.
+ *
+ * Os imóveis presentes ficam num IndiceEspacial; os inseridos depois da
+ * última construção ficam numa lista à parte, varrida com o kernel em lote,
+ * e o índice é reconstruído quando essa lista cresce demais.
+ */
+class AgendaIncremental {
+public:
+    /**
+     * @brief Assume a base com as rotas já geradas
+     * @param corretores Corretores
+     * @param rotas Rota de cada corretor (IDs na ordem de visita), indexadas por ID - 1
+     * @param imoveis Imóveis, indexados por ID - 1
+     * @param textos Arena dos textos da base; recebe também os dos cadastros novos
+     * @param configuracao Métrica de distância usada nas inserções e nos horários
+     */
+    AgendaIncremental(std::vector<Corretor> corretores, std::vector<std::vector<int>> rotas,
+                      std::vector<Imovel> imoveis, ArenaTextos textos, const ConfiguracaoRota& configuracao);
+
+    /**
+     * @brief Cadastra um imóvel e o insere na rota mais barata
+     * @param imovel Imóvel lido (o ID é reatribuído como o próximo da base)
+     * @return ID do corretor cuja rota foi alterada
+     * @throws std::runtime_error se não houver corretores avaliadores
+     */
+    int adicionarImovel(Imovel imovel);
+
+    /**
+     * @brief Retira um imóvel da rota em que está
+     * @param imovelId ID do imóvel
+     * @return ID do corretor cuja rota foi alterada
+     * @throws std::runtime_error se o imóvel não existir ou já tiver sido removido
+     */
+    int removerImovel(int imovelId);
+
+    /**
+     * @brief Cadastra um corretor (com rota vazia)
+     * @param corretor Corretor lido (o ID é reatribuído como o próximo da base)
+     * @return ID atribuído
+     */
+    int adicionarCorretor(Corretor corretor);
+
+    /**
+     * @brief Calcula os horários da rota atual de um corretor
+     * @param corretorId ID do corretor
+     * @throws std::runtime_error se o corretor não existir
+     */
+    std::vector<Agendamento> agenda(int corretorId) const;
+
+    /**
+     * @brief Distância total (km) percorrida por todos os corretores
+     */
+    double distanciaTotal() const;
+
+    const std::vector<Corretor>& listaCorretores() const { return corretores; }
+    int proximoImovelId() const { return static_cast<int>(imoveis.size()) + 1; }
+    int proximoCorretorId() const { return static_cast<int>(corretores.size()) + 1; }
+    ArenaTextos& arenaTextos() { return textos; }
+
+private:
+    std::vector<Corretor> corretores;
+    std::vector<std::vector<int>> rotas; ///< Por corretor: IDs dos imóveis na ordem de visita
+    std::vector<Imovel> imoveis;
+    ArenaTextos textos;
+    ConfiguracaoRota configuracao;
+
+    std::vector<std::vector<double>> trechos; ///< Por corretor: distância até cada visita desde a anterior
+    std::vector<int> donoDoImovel;   ///< Índice do corretor de cada imóvel (-1 se removido)
+    std::vector<int> posicaoNaRota;  ///< Posição de cada imóvel na rota do dono
+    int numAvaliadores = 0;
+    int numAgendados = 0;
+
+    // Busca espacial: índice construído + lista de inseridos depois dele
+    std::unique_ptr<IndiceEspacial> indice;
+    std::vector<int> imovelDoIndice;   ///< ID do imóvel em cada posição do índice
+    std::vector<int> posicaoNoIndice;  ///< Posição de cada imóvel no índice (-1 se ausente)
+    BlocoCoordenadas extras;
+    std::vector<int> imovelDoExtra;    ///< ID de cada extra (-1 se removido)
+    std::vector<int> extraDoImovel;    ///< Posição de cada imóvel na lista de extras (-1 se ausente)
+
+    void reconstruirIndice();
+    void vizinhosProximos(double lat, double lon, int k, std::vector<int>& ids) const;
+    void renumerar(const std::vector<int>& rota, int aPartirDe);
+    double distanciaAte(int c, int posicao, double lat, double lon) const;
+};
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file indice_espacial.cpp
+ * @brief Implementação da classe IndiceEspacial
+ * 
+ * Este arquivo contém a construção da árvore k-d, a busca do vizinho mais
+ * próximo com desempate por posição e a remoção de pontos visitados.
+ */
+
+#include "indice_espacial.h"
+#include "geografia.h"
+#include "metricas.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+/**
+ * @brief Constrói o índice sobre os pontos fornecidos
+ * 
+ * Monta a árvore dividindo sempre o eixo de maior extensão pela mediana e,
+ * ao final, copia os pontos para um bloco na ordem dos slots, de modo que
+ * cada folha ocupe memória contígua.
+ */
+IndiceEspacial::IndiceEspacial(const BlocoCoordenadas& pontos) {
+    int n = static_cast<int>(pontos.tamanho());
+
+    // Durante a construção, posicaoDoSlot guarda a permutação sendo particionada
+    posicaoDoSlot.resize(n);
+    std::iota(posicaoDoSlot.begin(), posicaoDoSlot.end(), 0);
+    folhaDoSlot.assign(n, -1);
+    if (n > 0) {
+        nos.reserve(4 * (n / TAMANHO_FOLHA + 1));
+        construir(pontos, 0, n, -1);
+    }
+
+    slots.reservar(n);
+    slotDaPosicao.resize(n);
+    for (int s = 0; s < n; ++s) {
+        int p = posicaoDoSlot[s];
+        slots.latitude.push_back(pontos.latitude[p]);
+        slots.longitude.push_back(pontos.longitude[p]);
+        slots.latRad.push_back(pontos.latRad[p]);
+        slots.lonRad.push_back(pontos.lonRad[p]);
+        slots.cosLat.push_back(pontos.cosLat[p]);
+        slots.sinLat.push_back(pontos.sinLat[p]);
+        slots.x.push_back(pontos.x[p]);
+        slots.y.push_back(pontos.y[p]);
+        slotDaPosicao[p] = s;
+    }
+    vivo.assign(n, 1);
+}
+
+/**
+ * @brief Constrói recursivamente o nó que cobre os slots [inicio, fim)
+ * @return Índice do nó criado
+ */
+int IndiceEspacial::construir(const BlocoCoordenadas& pontos, int inicio, int fim, int pai) {
+    int indice = static_cast<int>(nos.size());
+    nos.push_back(No{});
+    No no{};
+    no.inicio = inicio;
+    no.fim = fim;
+    no.esquerdo = -1;
+    no.direito = -1;
+    no.pai = pai;
+    no.vivos = fim - inicio;
+
+    const std::vector<double>* eixos[3] = {&pontos.x, &pontos.y, &pontos.sinLat};
+    for (int e = 0; e < 3; ++e) {
+        no.min[e] = std::numeric_limits<double>::max();
+        no.max[e] = std::numeric_limits<double>::lowest();
+        for (int s = inicio; s < fim; ++s) {
+            double v = (*eixos[e])[posicaoDoSlot[s]];
+            no.min[e] = std::min(no.min[e], v);
+            no.max[e] = std::max(no.max[e], v);
+        }
+    }
+
+    if (fim - inicio > TAMANHO_FOLHA) {
+        int eixo = 0;
+        for (int e = 1; e < 3; ++e) {
+            if (no.max[e] - no.min[e] > no.max[eixo] - no.min[eixo]) {
+                eixo = e;
+            }
+        }
+        const std::vector<double>& coord = *eixos[eixo];
+        int meio = inicio + (fim - inicio) / 2;
+        std::nth_element(posicaoDoSlot.begin() + inicio, posicaoDoSlot.begin() + meio,
+                         posicaoDoSlot.begin() + fim,
+                         [&coord](int a, int b) { return coord[a] < coord[b]; });
+        no.esquerdo = construir(pontos, inicio, meio, indice);
+        no.direito = construir(pontos, meio, fim, indice);
+    } else {
+        for (int s = inicio; s < fim; ++s) {
+            folhaDoSlot[s] = indice;
+        }
+    }
+
+    nos[indice] = no;
+    return indice;
+}
+
+/**
+ * @brief Encontra o ponto ainda presente no índice mais próximo da coordenada
+ * 
+ * Usa a própria função haversine na comparação final.
+ */
+int IndiceEspacial::maisProximo(double latConsulta, double lonConsulta, double& distancia) const {
+    return maisProximo(latConsulta, lonConsulta,
+                       [&](int posicao) {
+                           int s = slotDaPosicao[posicao];
+                           return haversine(latConsulta, lonConsulta, slots.latitude[s], slots.longitude[s]);
+                       },
+                       0.0, distancia);
+}
+
+/**
+ * @brief Encontra os k pontos ainda presentes mais próximos da coordenada
+ * 
+ * Mantém os k melhores candidatos (pelo quadrado da corda, com desempate
+ * pela posição) num vetor ordenado; uma sub-árvore é descartada quando a
+ * sua caixa está mais longe que o k-ésimo candidato.
+ */
+void IndiceEspacial::kMaisProximos(double latConsulta, double lonConsulta, int k,
+                                   std::vector<int>& posicoes, std::vector<double>& distancias) const {
+    posicoes.clear();
+    distancias.clear();
+    if (k <= 0 || nos.empty() || nos[0].vivos == 0) {
+        return;
+    }
+    METRICA_CONTAR(consultasVizinho, 1);
+
+    double q[3];
+    paraCartesiano(latConsulta, lonConsulta, q);
+
+    // Candidatos (corda², posição) em ordem crescente
+    std::vector<std::pair<double, int>> melhores;
+    melhores.reserve(k + 1);
+    auto limite = [&]() {
+        return static_cast<int>(melhores.size()) < k ? std::numeric_limits<double>::max()
+                                                     : melhores.back().first;
+    };
+
+    double cordas[TAMANHO_FOLHA];
+    std::vector<std::pair<int, double>> pilha;
+    pilha.reserve(64);
+    pilha.emplace_back(0, 0.0);
+    while (!pilha.empty()) {
+        auto [indice, caixa] = pilha.back();
+        pilha.pop_back();
+        if (caixa > limite()) {
+            continue;
+        }
+        const No& no = nos[indice];
+        if (no.esquerdo < 0) {
+            cordasQuadradasLote(slots, no.inicio, no.fim, q, cordas);
+            METRICA_CONTAR(candidatosVizinho, no.fim - no.inicio);
+            for (int s = no.inicio; s < no.fim; ++s) {
+                std::pair<double, int> candidato(cordas[s - no.inicio], posicaoDoSlot[s]);
+                if (!vivo[s] || (static_cast<int>(melhores.size()) == k && !(candidato < melhores.back()))) {
+                    continue;
+                }
+                melhores.insert(std::upper_bound(melhores.begin(), melhores.end(), candidato), candidato);
+                if (static_cast<int>(melhores.size()) > k) {
+                    melhores.pop_back();
+                }
+            }
+            continue;
+        }
+
+        const No& esq = nos[no.esquerdo];
+        const No& dir = nos[no.direito];
+        double caixaEsq = esq.vivos > 0 ? distanciaCaixaQuadrada(esq, q) : std::numeric_limits<double>::max();
+        double caixaDir = dir.vivos > 0 ? distanciaCaixaQuadrada(dir, q) : std::numeric_limits<double>::max();
+        if (caixaEsq <= caixaDir) {
+            if (dir.vivos > 0) pilha.emplace_back(no.direito, caixaDir);
+            if (esq.vivos > 0) pilha.emplace_back(no.esquerdo, caixaEsq);
+        } else {
+            if (esq.vivos > 0) pilha.emplace_back(no.esquerdo, caixaEsq);
+            if (dir.vivos > 0) pilha.emplace_back(no.direito, caixaDir);
+        }
+    }
+
+    for (const auto& [corda2, posicao] : melhores) {
+        posicoes.push_back(posicao);
+        distancias.push_back(cordaParaKm(std::sqrt(corda2)));
+    }
+}
+
+/**
+ * @brief Remove um ponto do índice
+ * 
+ * Marca o slot como removido e atualiza a contagem de pontos vivos de
+ * todos os ancestrais, para que sub-árvores vazias sejam ignoradas.
+ */
+void IndiceEspacial::remover(int posicao) {
+    int slot = slotDaPosicao[posicao];
+    if (!vivo[slot]) {
+        return;
+    }
+    vivo[slot] = 0;
+    for (int indice = folhaDoSlot[slot]; indice >= 0; indice = nos[indice].pai) {
+        nos[indice].vivos--;
+    }
+}
+
+/**
+ * @brief Informa quantos pontos ainda estão no índice
+ */
+int IndiceEspacial::tamanho() const {
+    return nos.empty() ? 0 : nos[0].vivos;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file indice_espacial.h
+ * @brief Definição da classe IndiceEspacial (árvore k-d com remoção)
+ * 
+ * O índice acelera a busca do vizinho mais próximo usada no agendamento,
+ * substituindo a varredura linear de todos os imóveis do corretor.
+ */
+
+#ifndef INDICE_ESPACIAL_H
+#define INDICE_ESPACIAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "coordenadas.h"
+#include "geografia.h"
+#include "metricas.h"
+
+/**
+ * @class IndiceEspacial
+ * @brief Árvore k-d sobre pontos da esfera unitária com suporte a remoção
+ * 
+ * Os pontos são identificados pela sua posição no vetor de entrada. A busca
+ * devolve sempre o mesmo resultado da varredura linear com Haversine: a menor
+ * distância vence e, em caso de empate, vence a menor posição. As caixas
+ * envolventes são usadas apenas para descartar sub-árvores; a comparação
+ * final entre candidatos usa a própria função haversine.
+ * 
+ * Os pontos ficam num BlocoCoordenadas ordenado pelas folhas da árvore, e
+ * cada folha é avaliada com o kernel em lote (cordasQuadradasLote); apenas
+ * os pontos que podem empatar ou vencer o melhor atual passam por haversine.
+ * 
+ * Construção em O(n log n); cada consulta custa O(log n) em média e cada
+ * remoção O(log n).
+ */
+class IndiceEspacial {
+public:
+    /**
+     * @brief Constrói o índice sobre os pontos fornecidos
+     * @param pontos Coordenadas dos pontos; a posição no bloco identifica o ponto
+     */
+    explicit IndiceEspacial(const BlocoCoordenadas& pontos);
+
+    /**
+     * @brief Encontra o ponto ainda presente no índice mais próximo da coordenada
+     * @param lat Latitude da origem da busca
+     * @param lon Longitude da origem da busca
+     * @param distancia Recebe a distância de Haversine (km) até o ponto encontrado
+     * @return Posição do ponto mais próximo, ou -1 se o índice estiver vazio
+     */
+    int maisProximo(double lat, double lon, double& distancia) const;
+
+    /**
+     * @brief Variante de maisProximo em que a distância final vem de outra métrica
+     * 
+     * Os candidatos continuam sendo filtrados pela corda, mas a comparação
+     * entre eles usa distanciaExata(posicao). A métrica deve diferir de
+     * haversine em no máximo margemRelativa * d (mais a tolerância interna),
+     * para que nenhum candidato que ela escolheria seja descartado.
+     * 
+     * @param lat Latitude da origem da busca
+     * @param lon Longitude da origem da busca
+     * @param distanciaExata Função (km) da posição do ponto até a origem; é um
+     *        parâmetro de modelo para ser expandida no laço das folhas
+     * @param margemRelativa Erro relativo máximo da métrica em relação a haversine
+     * @param distancia Recebe a distância até o ponto encontrado
+     * @return Posição do ponto mais próximo, ou -1 se o índice estiver vazio
+     */
+    template <typename Metrica>
+    int maisProximo(double lat, double lon, const Metrica& distanciaExata,
+                    double margemRelativa, double& distancia) const;
+
+    /**
+     * @brief Encontra os k pontos ainda presentes mais próximos da coordenada
+     * 
+     * Ao contrário de maisProximo, as distâncias vêm do kernel em lote (sem
+     * confirmação por haversine); serve para heurísticas como a atribuição
+     * por agrupamento, em que diferenças abaixo de 1e-9 km não importam.
+     * 
+     * @param lat Latitude da origem da busca
+     * @param lon Longitude da origem da busca
+     * @param k Número de vizinhos desejados
+     * @param posicoes Recebe as posições, da mais próxima para a mais distante
+     * @param distancias Recebe as distâncias em km correspondentes
+     */
+    void kMaisProximos(double lat, double lon, int k,
+                       std::vector<int>& posicoes, std::vector<double>& distancias) const;
+
+    /**
+     * @brief Remove um ponto do índice (por exemplo, um imóvel já visitado)
+     * @param posicao Posição do ponto no vetor usado na construção
+     */
+    void remover(int posicao);
+
+    /**
+     * @brief Informa quantos pontos ainda estão no índice
+     * @return Número de pontos não removidos
+     */
+    int tamanho() const;
+
+private:
+    static constexpr int TAMANHO_FOLHA = 16; ///< Máximo de pontos por folha
+
+    // Margem (km) somada à melhor distância antes de descartar candidatos pela
+    // corda. Cobre a diferença entre a corda em 3D e a função haversine (até
+    // ~2e-4 km perto de pontos antípodas, ver coordenadas.h), de modo que nenhum
+    // candidato empatado seja descartado.
+    static constexpr double TOLERANCIA_KM = 1e-3;
+
+    // Folga absoluta no quadrado da corda, para o arredondamento do próprio kernel
+    static constexpr double TOLERANCIA_CORDA = 1e-12;
+
+    /// Nó da árvore: caixa envolvente 3D e faixa de slots que ele cobre
+    struct No {
+        double min[3];
+        double max[3];
+        int inicio;   ///< Primeiro slot coberto pelo nó
+        int fim;      ///< Slot seguinte ao último coberto
+        int esquerdo; ///< Filho esquerdo (-1 em folhas)
+        int direito;  ///< Filho direito (-1 em folhas)
+        int pai;      ///< Nó pai (-1 na raiz)
+        int vivos;    ///< Pontos ainda não removidos na sub-árvore
+    };
+
+    // Dados armazenados por slot, já na ordem das folhas da árvore
+    BlocoCoordenadas slots;
+    std::vector<int> posicaoDoSlot;
+    std::vector<char> vivo;
+
+    std::vector<int> slotDaPosicao;
+    std::vector<int> folhaDoSlot;
+    std::vector<No> nos;
+
+    int construir(const BlocoCoordenadas& pontos, int inicio, int fim, int pai);
+    static double distanciaCaixaQuadrada(const No& no, const double q[3]);
+    static double limiteCordaQuadrada(double distanciaKm, double margemRelativa);
+};
+
+/**
+ * @brief Quadrado da distância euclidiana entre a consulta e a caixa do nó
+ * 
+ * É um limite inferior para a corda até qualquer ponto do nó. Fica no
+ * cabeçalho porque é chamada a cada nó visitado pelas buscas.
+ */
+inline double IndiceEspacial::distanciaCaixaQuadrada(const No& no, const double q[3]) {
+    double soma = 0.0;
+    for (int e = 0; e < 3; ++e) {
+        double d = 0.0;
+        if (q[e] < no.min[e]) {
+            d = no.min[e] - q[e];
+        } else if (q[e] > no.max[e]) {
+            d = q[e] - no.max[e];
+        }
+        soma += d * d;
+    }
+    return soma;
+}
+
+/**
+ * Quadrado da maior corda que ainda pode empatar com a distância dada,
+ * numa métrica que difere de haversine em até margemRelativa
+ */
+inline double IndiceEspacial::limiteCordaQuadrada(double distanciaKm, double margemRelativa) {
+    if (distanciaKm == std::numeric_limits<double>::max()) {
+        return std::numeric_limits<double>::max();
+    }
+    double alcance = (distanciaKm + TOLERANCIA_KM) / (1.0 - margemRelativa);
+    double angulo = std::min(M_PI / 2, alcance / (2.0 * EARTH_R));
+    double corda = 2.0 * std::sin(angulo);
+    return corda * corda + TOLERANCIA_CORDA;
+}
+
+/**
+ * @brief Variante de maisProximo com outra métrica na comparação final
+ * 
+ * Busca em profundidade visitando primeiro o filho mais próximo. As folhas
+ * são filtradas em lote pelo quadrado da corda; uma sub-árvore ou um ponto só
+ * é descartado quando não pode empatar com a melhor distância encontrada,
+ * com o limite alargado pela margem da métrica.
+ */
+template <typename Metrica>
+int IndiceEspacial::maisProximo(double latConsulta, double lonConsulta, const Metrica& distanciaExata,
+                                double margemRelativa, double& distancia) const {
+    int melhorPosicao = -1;
+    double menorDistancia = std::numeric_limits<double>::max();
+    double limite = std::numeric_limits<double>::max();
+    if (nos.empty() || nos[0].vivos == 0) {
+        return -1;
+    }
+    METRICA_CONTAR(consultasVizinho, 1);
+
+    double q[3];
+    paraCartesiano(latConsulta, lonConsulta, q);
+
+    double cordas[TAMANHO_FOLHA];
+    std::vector<std::pair<int, double>> pilha;
+    pilha.reserve(64);
+    pilha.emplace_back(0, 0.0);
+    while (!pilha.empty()) {
+        auto [indice, caixa] = pilha.back();
+        pilha.pop_back();
+        if (caixa > limite) {
+            continue;
+        }
+        const No& no = nos[indice];
+        if (no.esquerdo < 0) {
+            cordasQuadradasLote(slots, no.inicio, no.fim, q, cordas);
+            METRICA_CONTAR(candidatosVizinho, no.fim - no.inicio);
+            for (int s = no.inicio; s < no.fim; ++s) {
+                if (!vivo[s] || cordas[s - no.inicio] > limite) {
+                    continue;
+                }
+                int p = posicaoDoSlot[s];
+                METRICA_CONTAR(confirmacoesVizinho, 1);
+                double d = distanciaExata(p);
+                if (d < menorDistancia || (d == menorDistancia && p < melhorPosicao)) {
+                    menorDistancia = d;
+                    melhorPosicao = p;
+                    limite = limiteCordaQuadrada(menorDistancia, margemRelativa);
+                }
+            }
+            continue;
+        }
+
+        const No& esq = nos[no.esquerdo];
+        const No& dir = nos[no.direito];
+        double caixaEsq = esq.vivos > 0 ? distanciaCaixaQuadrada(esq, q) : std::numeric_limits<double>::max();
+        double caixaDir = dir.vivos > 0 ? distanciaCaixaQuadrada(dir, q) : std::numeric_limits<double>::max();
+        // Empilhar primeiro o mais distante, para visitar antes o mais próximo
+        if (caixaEsq <= caixaDir) {
+            if (dir.vivos > 0 && caixaDir <= limite) pilha.emplace_back(no.direito, caixaDir);
+            if (esq.vivos > 0 && caixaEsq <= limite) pilha.emplace_back(no.esquerdo, caixaEsq);
+        } else {
+            if (esq.vivos > 0 && caixaEsq <= limite) pilha.emplace_back(no.esquerdo, caixaEsq);
+            if (dir.vivos > 0 && caixaDir <= limite) pilha.emplace_back(no.direito, caixaDir);
+        }
+    }
+
+    distancia = menorDistancia;
+    return melhorPosicao;
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file leitor.cpp
+ * @brief Implementação do leitor da entrada sem cópias
+ * 
+ * O carregamento do buffer (mmap ou leitura em blocos) fica em ArquivoMapeado;
+ * aqui ficam apenas as rotinas de extração dos campos.
+ */
+
+#include "leitor.h"
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace {
+
+/**
+ * Espaço em branco segundo a localidade "C", a mesma usada por std::cin
+ */
+inline bool ehEspaco(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool ehDigito(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+/**
+ * @brief Carrega toda a entrada do descritor de arquivo indicado
+ */
+LeitorEntrada::LeitorEntrada(int fd)
+    : arquivo(fd), inicio(arquivo.dados()), atual(inicio), fim(inicio + arquivo.tamanho()) {
+}
+
+/**
+ * @brief Abre e carrega o arquivo indicado
+ */
+LeitorEntrada::LeitorEntrada(const std::string& caminho)
+    : arquivo(caminho), inicio(arquivo.dados()), atual(inicio), fim(inicio + arquivo.tamanho()) {
+}
+
+/**
+ * @brief Lê de um texto já em memória
+ */
+LeitorEntrada::LeitorEntrada(const char* texto, std::size_t tamanho)
+    : inicio(texto), atual(inicio), fim(inicio + tamanho) {
+}
+
+void LeitorEntrada::pularEspacos() {
+    while (atual < fim && ehEspaco(*atual)) {
+        ++atual;
+    }
+}
+
+/**
+ * @brief Lê um inteiro, como "std::cin >> valor"
+ * 
+ * Aceita sinal opcional ('+' ou '-'); valores fora do intervalo de int
+ * são tratados como falha, assim como no stream.
+ */
+bool LeitorEntrada::lerInteiro(int& valor) {
+    if (falhou) {
+        return false;
+    }
+    pularEspacos();
+    const char* p = atual;
+    if (p < fim && *p == '+' && p + 1 < fim && ehDigito(p[1])) {
+        ++p; // from_chars não aceita '+'
+    }
+    auto [ptr, erro] = std::from_chars(p, fim, valor);
+    if (erro != std::errc()) {
+        falhou = true;
+        return false;
+    }
+    atual = ptr;
+    return true;
+}
+
+/**
+ * @brief Lê um número real, como "std::cin >> valor"
+ * 
+ * Rejeita "inf" e "nan", que std::from_chars aceita mas std::cin não.
+ */
+bool LeitorEntrada::lerReal(double& valor) {
+    if (falhou) {
+        return false;
+    }
+    pularEspacos();
+    const char* p = atual;
+    if (p < fim && *p == '+') {
+        ++p; // from_chars não aceita '+'
+    }
+    const char* q = (p < fim && *p == '-') ? p + 1 : p;
+    if (q >= fim || !(ehDigito(*q) || *q == '.')) {
+        falhou = true;
+        return false;
+    }
+    auto [ptr, erro] = std::from_chars(p, fim, valor);
+    if (erro != std::errc()) {
+        falhou = true;
+        return false;
+    }
+    atual = ptr;
+    return true;
+}
+
+/**
+ * @brief Lê uma sequência de caracteres sem espaços, como "std::cin >> texto"
+ */
+bool LeitorEntrada::lerPalavra(std::string_view& palavra) {
+    if (falhou) {
+        return false;
+    }
+    pularEspacos();
+    if (atual >= fim) {
+        falhou = true;
+        return false;
+    }
+    const char* comeco = atual;
+    while (atual < fim && !ehEspaco(*atual)) {
+        ++atual;
+    }
+    palavra = std::string_view(comeco, static_cast<std::size_t>(atual - comeco));
+    return true;
+}
+
+/**
+ * @brief Ignora espaços em branco e lê até o fim da linha
+ * 
+ * Como std::getline, consome o '\n' mas não o inclui no resultado. O fim
+ * da linha é procurado com memchr: nomes e endereços são os campos mais
+ * longos da entrada, e na leitura das rotas só são conferidos e descartados.
+ */
+std::string_view LeitorEntrada::lerRestoDaLinha() {
+    if (falhou) {
+        return {};
+    }
+    pularEspacos();
+    if (atual >= fim) {
+        falhou = true;
+        return {};
+    }
+    const char* comeco = atual;
+    const char* quebra = static_cast<const char*>(std::memchr(atual, '\n', static_cast<std::size_t>(fim - atual)));
+    atual = quebra ? quebra : fim;
+    std::string_view linha(comeco, static_cast<std::size_t>(atual - comeco));
+    if (atual < fim) {
+        ++atual;
+    }
+    return linha;
+}
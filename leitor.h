@@ -0,0 +1,104 @@
+/**
+ * @file leitor.h
+ * @brief Leitor da entrada sem cópias, baseado em mapeamento de memória
+ * 
+ * Substitui a extração com std::cin na leitura dos dados. A entrada inteira
+ * fica num único buffer (mapeado com mmap quando é um arquivo redirecionado,
+ * ou lido em blocos grandes quando é um pipe) e os campos de texto são
+ * devolvidos como std::string_view apontando para esse buffer.
+ */
+
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "mapeamento.h"
+
+/**
+ * @class LeitorEntrada
+ * @brief Extrai números e textos de um buffer com a mesma semântica de std::cin
+ * 
+ * lerInteiro/lerReal/lerPalavra equivalem a "std::cin >> valor" (ignoram
+ * espaços em branco antes do campo e consomem o maior prefixo válido) e
+ * lerRestoDaLinha equivale a "std::getline(std::cin >> std::ws, texto)".
+ * Assim como no stream, depois de uma falha todas as leituras seguintes
+ * também falham. Os números são convertidos com std::from_chars.
+ * 
+ * As views devolvidas continuam válidas enquanto o leitor existir.
+ */
+class LeitorEntrada {
+public:
+    /**
+     * @brief Carrega toda a entrada do descritor de arquivo indicado
+     * @param fd Descritor de arquivo (por exemplo, 0 para a entrada padrão)
+     */
+    explicit LeitorEntrada(int fd);
+
+    /**
+     * @brief Abre e carrega o arquivo indicado
+     * @param caminho Caminho do arquivo
+     * @throws std::runtime_error se o arquivo não puder ser aberto
+     */
+    explicit LeitorEntrada(const std::string& caminho);
+
+    /**
+     * @brief Lê de um texto já em memória (por exemplo, uma linha de comando)
+     * @param texto Início do texto; precisa continuar válido enquanto o leitor existir
+     * @param tamanho Número de bytes do texto
+     */
+    LeitorEntrada(const char* texto, std::size_t tamanho);
+
+    /**
+     * @brief Lê um inteiro, como "std::cin >> valor"
+     * @return false se não houver um inteiro válido
+     */
+    bool lerInteiro(int& valor);
+
+    /**
+     * @brief Lê um número real, como "std::cin >> valor"
+     * @return false se não houver um número válido
+     */
+    bool lerReal(double& valor);
+
+    /**
+     * @brief Lê uma sequência de caracteres sem espaços, como "std::cin >> texto"
+     * @return false se a entrada terminou
+     */
+    bool lerPalavra(std::string_view& palavra);
+
+    /**
+     * @brief Ignora espaços em branco (inclusive quebras de linha) e lê até o fim da linha
+     * @return Texto lido, sem o '\n'; vazio se a entrada terminou
+     */
+    std::string_view lerRestoDaLinha();
+
+    /**
+     * @brief Número de bytes já consumidos do buffer
+     */
+    std::size_t bytesConsumidos() const { return static_cast<std::size_t>(atual - inicio); }
+
+    /**
+     * @brief Número de bytes ainda não consumidos do buffer
+     */
+    std::size_t bytesRestantes() const { return static_cast<std::size_t>(fim - atual); }
+
+    /**
+     * @brief Libera a memória do trecho já consumido (ver ArquivoMapeado::descartarAte)
+     * 
+     * Só pode ser chamado quando nenhuma view devolvida pelo leitor estiver em uso.
+     */
+    void descartarConsumido() { arquivo.descartarAte(atual); }
+
+private:
+    ArquivoMapeado arquivo;
+    const char* inicio = nullptr;
+    const char* atual = nullptr;
+    const char* fim = nullptr;
+    bool falhou = false;
+
+    void pularEspacos();
+};
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * @file lote.cpp
+ * @brief Implementação do modo lote
+ */
+
+#include "lote.h"
+#include "atribuicao.h"
+#include "dados.h"
+#include "leitor.h"
+#include "metricas.h"
+#include "paralelo.h"
+#include "saida.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Estado de uma região durante o processamento
+ */
+struct Regiao {
+    ParLote arquivos;
+    BaseDados base;
+    Atribuicao atribuicao;                        ///< Imóveis de cada avaliador
+    std::vector<int> comImoveis;                  ///< Avaliadores com imóveis (posições em atribuicao)
+    std::vector<std::vector<Agendamento>> agendas; ///< Agenda de cada um de comImoveis
+    std::string erro;                             ///< Primeiro erro (vazio se tudo correu bem)
+    std::mutex travaErro;
+
+    void registrarErro(const std::string& mensagem) {
+        std::lock_guard<std::mutex> trava(travaErro);
+        if (erro.empty()) {
+            erro = mensagem;
+        }
+    }
+};
+
+/**
+ * Uma rota a gerar: corretor k (em comImoveis) da região r
+ */
+struct TarefaRota {
+    int regiao;
+    int corretor;
+    std::size_t imoveis;
+};
+
+/**
+ * Lê a base e distribui os imóveis (a atribuição roda numa thread só,
+ * já que as regiões são processadas em paralelo)
+ */
+void prepararRegiao(Regiao& regiao, const Opcoes& opcoes) {
+    BaseDados& base = regiao.base;
+    LeitorEntrada entrada(regiao.arquivos.entrada);
+    lerDados(entrada, base.corretores, base.clientes, base.imoveis, base.textos, ProjecaoBase::Rotas);
+    std::vector<const Corretor*> avaliadores = selecionarAvaliadores(base.corretores, base.imoveis);
+    regiao.atribuicao = atribuirImoveis(base.imoveis, avaliadores, opcoes.atribuicao, 1);
+    for (int k = 0; k < regiao.atribuicao.numAvaliadores(); ++k) {
+        if (!regiao.atribuicao.imoveisDe(k).vazia()) {
+            regiao.comImoveis.push_back(k);
+        }
+    }
+    regiao.agendas.resize(regiao.comImoveis.size());
+}
+
+/**
+ * Grava as agendas da região e libera a sua base
+ */
+void escreverRegiao(Regiao& regiao, const Opcoes& opcoes) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> arquivo(
+        std::fopen(regiao.arquivos.saida.c_str(), "wb"), &std::fclose);
+    if (!arquivo) {
+        throw std::runtime_error("Erro: não foi possível criar " + regiao.arquivos.saida);
+    }
+    {
+        EscritorAgenda escritor(opcoes.formato, arquivo.get());
+        for (std::size_t k = 0; k < regiao.comImoveis.size(); ++k) {
+            escritor.escreverCorretor(regiao.atribuicao.avaliadores[regiao.comImoveis[k]]->id, regiao.agendas[k]);
+        }
+        escritor.finalizar();
+    }
+    if (std::fclose(arquivo.release()) != 0) {
+        throw std::runtime_error("Erro: falha ao gravar " + regiao.arquivos.saida);
+    }
+    regiao.agendas = {};
+    regiao.comImoveis = {};
+    regiao.atribuicao = Atribuicao();
+    regiao.base = BaseDados();
+}
+
+} // namespace
+
+/**
+ * @brief Lê o manifesto do modo lote
+ */
+std::vector<ParLote> lerManifesto(const std::string& caminho) {
+    std::ifstream manifesto(caminho);
+    if (!manifesto) {
+        throw std::runtime_error("Erro: não foi possível abrir o manifesto " + caminho);
+    }
+    std::vector<ParLote> pares;
+    std::string linha;
+    for (int numero = 1; std::getline(manifesto, linha); ++numero) {
+        std::istringstream campos(linha);
+        ParLote par;
+        std::string sobra;
+        if (!(campos >> par.entrada) || par.entrada[0] == '#') {
+            continue;
+        }
+        if (!(campos >> par.saida) || (campos >> sobra)) {
+            throw std::runtime_error("Erro: manifesto " + caminho + ", linha " + std::to_string(numero) +
+                                     ": use \"entrada saída\"");
+        }
+        pares.push_back(par);
+    }
+    if (pares.empty()) {
+        throw std::runtime_error("Erro: o manifesto " + caminho + " não tem nenhuma região");
+    }
+    return pares;
+}
+
+/**
+ * @brief Processa todas as regiões do manifesto
+ */
+int executarLote(const Opcoes& opcoes) {
+    auto inicioExecucao = std::chrono::steady_clock::now();
+    std::vector<ParLote> pares = lerManifesto(opcoes.manifestoLote);
+    std::vector<Regiao> regioes(pares.size());
+    for (std::size_t r = 0; r < pares.size(); ++r) {
+        regioes[r].arquivos = pares[r];
+    }
+    int numRegioes = static_cast<int>(regioes.size());
+
+    // Leitura e atribuição: uma tarefa por região
+    executarEmParalelo(numRegioes, opcoes.threads, [&](int r) {
+        try {
+            prepararRegiao(regioes[r], opcoes);
+        } catch (const std::exception& e) {
+            regioes[r].registrarErro(e.what());
+        }
+    });
+    double preparoMs = milissegundosDesde(inicioExecucao);
+
+    // Rotas: uma tarefa por corretor de todas as regiões, maiores primeiro
+    auto inicioFase = std::chrono::steady_clock::now();
+    std::vector<TarefaRota> tarefas;
+    std::size_t totalImoveis = 0;
+    for (int r = 0; r < numRegioes; ++r) {
+        totalImoveis += regioes[r].base.imoveis.size();
+        for (std::size_t k = 0; k < regioes[r].comImoveis.size(); ++k) {
+            tarefas.push_back({r, static_cast<int>(k),
+                               regioes[r].atribuicao.imoveisDe(regioes[r].comImoveis[k]).tamanho()});
+        }
+    }
+    std::stable_sort(tarefas.begin(), tarefas.end(), [](const TarefaRota& a, const TarefaRota& b) {
+        return a.imoveis > b.imoveis;
+    });
+    executarEmParalelo(static_cast<int>(tarefas.size()), opcoes.threads, [&](int t) {
+        Regiao& regiao = regioes[tarefas[t].regiao];
+        int k = tarefas[t].corretor;
+        try {
+            int avaliador = regiao.comImoveis[k];
+            regiao.agendas[k] = gerarAgendamentoCorretor(regiao.base.imoveis, *regiao.atribuicao.avaliadores[avaliador],
+                                                         regiao.atribuicao.imoveisDe(avaliador), opcoes.rota);
+        } catch (const std::exception& e) {
+            regiao.registrarErro(e.what());
+        }
+    });
+    double rotasMs = milissegundosDesde(inicioFase);
+
+    // Escrita: uma tarefa por região
+    inicioFase = std::chrono::steady_clock::now();
+    executarEmParalelo(numRegioes, opcoes.threads, [&](int r) {
+        if (!regioes[r].erro.empty()) {
+            return;
+        }
+        try {
+            escreverRegiao(regioes[r], opcoes);
+        } catch (const std::exception& e) {
+            regioes[r].registrarErro(e.what());
+        }
+    });
+    double saidaMs = milissegundosDesde(inicioFase);
+
+    int falhas = 0;
+    for (const auto& regiao : regioes) {
+        if (!regiao.erro.empty()) {
+            std::cerr << regiao.arquivos.entrada << ": " << regiao.erro << std::endl;
+            ++falhas;
+        }
+    }
+    if (opcoes.relatarTempos) {
+        escreverTemposJson(std::cerr,
+                           {{"regioes", regioes.size()},
+                            {"falhas", static_cast<std::size_t>(falhas)},
+                            {"imoveis", totalImoveis},
+                            {"rotas", tarefas.size()},
+                            {"threads", static_cast<std::size_t>(opcoes.threads)}},
+                           {{"preparo_ms", preparoMs},
+                            {"rotas_ms", rotasMs},
+                            {"saida_ms", saidaMs},
+                            {"total_ms", milissegundosDesde(inicioExecucao)}});
+    }
+    return falhas > 0 ? 1 : 0;
+}
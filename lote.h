@@ -0,0 +1,49 @@
+/**
+ * @file lote.h
+ * @brief Modo lote: várias bases (regiões) num só processo
+ *
+ * O manifesto tem um par "entrada saída" por linha (arquivos de texto no
+ * formato da entrada padrão e da saída); linhas vazias e iniciadas por '#'
+ * são ignoradas. Cada saída é idêntica à de uma execução separada com a
+ * mesma entrada e as mesmas opções.
+ *
+ * As três fases (leitura e atribuição, rotas, escrita) usam o mesmo
+ * conjunto de threads. Na fase das rotas, as tarefas são as rotas de todos
+ * os corretores de todas as regiões, das maiores para as menores, então uma
+ * região grande não deixa threads paradas enquanto as pequenas terminam.
+ *
+ * Uma região com erro não interrompe as demais: o erro é informado na
+ * saída de erro, precedido do nome da entrada, e a saída dela não é criada.
+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <string>
+#include <vector>
+#include "opcoes.h"
+
+/**
+ * @struct ParLote
+ * @brief Uma linha do manifesto
+ */
+struct ParLote {
+    std::string entrada; ///< Base da região (texto)
+    std::string saida;   ///< Arquivo que recebe as agendas
+};
+
+/**
+ * @brief Lê o manifesto do modo lote
+ * @throws std::runtime_error se o arquivo não existir, tiver linha malformada ou nenhum par
+ */
+std::vector<ParLote> lerManifesto(const std::string& caminho);
+
+/**
+ * @brief Processa todas as regiões do manifesto de opcoes.manifestoLote
+ * @param opcoes Opções da execução (threads, atribuição, rota, formato, --timings)
+ * @return 0 se todas as regiões foram agendadas, 1 se alguma falhou
+ * @throws std::runtime_error se o manifesto for inválido
+ */
+int executarLote(const Opcoes& opcoes);
+
+#endif
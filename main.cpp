@@ -6,13 +6,15 @@
  * para minimizar o tempo de deslocamento.
  * 
  * Algoritmo implementado:
- * 1. Distribuição Round-Robin dos imóveis entre avaliadores
- * 2. Para cada avaliador: algoritmo do vizinho mais próximo
+ * 1. Distribuição Round-Robin dos imóveis entre avaliadores (ou agrupamento espacial)
+ * 2. Para cada avaliador: algoritmo do vizinho mais próximo (com índice espacial),
+ *    opcionalmente melhorado por 2-opt/Or-opt
  * 3. Cálculo de tempo: 2 min/km deslocamento + 1 hora avaliação
  * 
 
  */
 
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <algorithm>
@@ -20,320 +22,340 @@
 #include <iomanip>
 #include <sstream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include "corretor.h"
+#include "curva.h"
 #include "cliente.h"
 #include "imovel.h"
-
-constexpr double EARTH_R = 6371.0; // Raio da Terra em km
-constexpr int HORA_INICIO = 9;     // Hora de início das avaliações
-constexpr int MINUTOS_INICIO = 0;  // Minuto de início
-constexpr int DURACAO_AVALIACAO = 60; // Duração da avaliação em minutos
-constexpr double TEMPO_DESLOCAMENTO_POR_KM = 2.0; // Minutos por km
-
-/**
- * Calcula a distância em km entre duas coordenadas geográficas
- * usando a fórmula de Haversine
- * 
- * @param lat1 Latitude do primeiro ponto
- * @param lon1 Longitude do primeiro ponto
- * @param lat2 Latitude do segundo ponto
- * @param lon2 Longitude do segundo ponto
- * @return Distância em quilômetros
- */
-double haversine(double lat1, double lon1, double lat2, double lon2) {
-    auto deg2rad = [](double d){ return d * M_PI / 180.0; };
-    double dlat = deg2rad(lat2 - lat1);
-    double dlon = deg2rad(lon2 - lon1);
-    double a = std::pow(std::sin(dlat/2), 2) +
-               std::cos(deg2rad(lat1)) * std::cos(deg2rad(lat2)) *
-               std::pow(std::sin(dlon/2), 2);
-    double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
-    return EARTH_R * c;
-}
-
-/**
- * Estrutura para armazenar informações de um agendamento
- */
-struct Agendamento {
-    int hora;
-    int minuto;
-    int imovelId;
-    
-    Agendamento(int h, int m, int id) : hora(h), minuto(m), imovelId(id) {}
-};
-
-/**
- * Converte minutos desde o início do dia (09:00) para formato hora:minuto
- * 
- * @param minutos Minutos desde 09:00
- * @return Par (hora, minuto) no formato 24h
- */
-std::pair<int, int> minutosParaHoraMinuto(int minutos) {
-    int totalMinutos = HORA_INICIO * 60 + MINUTOS_INICIO + minutos;
-    int hora = totalMinutos / 60;
-    int minuto = totalMinutos % 60;
-    return {hora, minuto};
-}
+#include "agendamento.h"
+#include "checkpoint.h"
+#include "dados.h"
+#include "esteira.h"
+#include "leitor.h"
+#include "lote.h"
+#include "metricas.h"
+#include "atribuicao.h"
+#include "opcoes.h"
+#include "incremental.h"
+#include "paralelo.h"
+#include "rebalanceamento.h"
+#include "rede_viaria.h"
+#include "saida.h"
+#include "servico.h"
+#include "snapshot.h"
+#include "textos.h"
 
 /**
- * Encontra o imóvel mais próximo não visitado para um corretor
- * 
- * @param imoveis Lista de todos os imóveis
- * @param imoveisCorretor IDs dos imóveis atribuídos ao corretor
- * @param visitados Vetor indicando quais imóveis já foram visitados
- * @param latAtual Latitude atual do corretor
- * @param lonAtual Longitude atual do corretor
- * @return ID do imóvel mais próximo, ou -1 se não houver mais imóveis
- */
-int encontrarImovelMaisProximo(const std::vector<Imovel>& imoveis, 
-                               const std::vector<int>& imoveisCorretor,
-                               const std::vector<bool>& visitados,
-                               double latAtual, double lonAtual) {
-    int melhorImovel = -1;
-    double menorDistancia = std::numeric_limits<double>::max();
-    
-    for (int imovelId : imoveisCorretor) {
-        if (!visitados[imovelId - 1]) { // IDs começam em 1, índices em 0
-            double distancia = haversine(latAtual, lonAtual, 
-                                       imoveis[imovelId - 1].latitude, 
-                                       imoveis[imovelId - 1].longitude);
-            if (distancia < menorDistancia) {
-                menorDistancia = distancia;
-                melhorImovel = imovelId;
-            }
-        }
-    }
-    
-    return melhorImovel;
-}
-
-/**
- * Gera o agendamento otimizado para um corretor usando o algoritmo
- * do vizinho mais próximo
+ * Função principal do programa
  * 
- * @param imoveis Lista de todos os imóveis
- * @param corretor Corretor para o qual gerar o agendamento
- * @return Lista de agendamentos ordenados por horário
+ * Opções: --threads N gera as rotas dos corretores em N threads. A saída
+ * continua na ordem dos IDs e é idêntica à execução serial.
+ * --export-snapshot ARQ grava a base lida num snapshot binário e encerra;
+ * --load-snapshot ARQ lê a base do snapshot em vez da entrada padrão.
+ * --assign=roundrobin|cluster escolhe a distribuição dos imóveis e informa
+ * na saída de erro a distância total percorrida.
+ * --route=nn|sfc escolhe a ordem inicial das visitas: vizinho mais próximo
+ * ou curva de Hilbert (O(n log n), para corretores com muitos imóveis).
+ * --reorder=hilbert coloca a base em ordem da curva logo após a leitura
+ * (ver curva.h); a saída continua com os IDs da entrada.
+ * --collapse-m M ordena as visitas sobre paradas que agrupam os imóveis a
+ * até M metros uns dos outros (ver paradas.h) e informa a redução.
+ * --improve-ms N aplica 2-opt/Or-opt a cada rota por até N ms.
+ * --exact-max N usa o caminho ótimo exato (Held-Karp) nas rotas com até
+ * N imóveis (no máximo 20).
+ * --rebalance-ms N move imóveis entre as rotas por até N ms para antecipar
+ * o fim da última visita (ver rebalanceamento.h; --rebalance-rounds,
+ * --rebalance-starts e --seed controlam a busca).
+ * --distance=haversine|cache|equirect escolhe o provedor de distâncias e
+ * informa na saída de erro as consultas, acertos de cache e cálculos.
+ * --service-time=fixed|bytype escolhe a duração das avaliações (1 hora ou
+ * conforme o tipo do imóvel).
+ * --timings informa na saída de erro, numa linha JSON, o tempo de cada
+ * fase (leitura, atribuição, rotas, saída).
+ * --metrics=json publica fases, contadores e custo por corretor em JSON na
+ * saída de erro (ou em --metrics-file ARQ).
+ * --input ARQ lê a base de um arquivo texto em vez da entrada padrão.
+ * --daemon (com --input ou --load-snapshot) imprime as agendas e passa a
+ * aceitar comandos de atualização na entrada padrão; --socket ARQ recebe
+ * os comandos num socket Unix (ver servico.h).
+ * --format=text|csv|jsonl escolhe o formato da listagem.
+ * --batch ARQ processa várias regiões (pares entrada/saída do manifesto)
+ * num só processo, com as rotas de todas no mesmo conjunto de threads.
+ * --road-network ARQ mede as rotas pela malha viária do arquivo (ver
+ * rede_viaria.h), pré-processada uma vez antes da leitura da base.
+ * --pipeline sobrepõe leitura, atribuição, rotas e escrita (ver esteira.h):
+ * cada agenda é impressa assim que ela e as anteriores ficam prontas.
+ * --checkpoint ARQ grava a atribuição e as rotas prontas a cada
+ * --checkpoint-ms N ms; com --resume, uma execução interrompida continua
+ * de onde o checkpoint parou (ver checkpoint.h).
  */
-std::vector<Agendamento> gerarAgendamentoCorretor(const std::vector<Imovel>& imoveis,
-                                                  const Corretor& corretor) {
-    std::vector<Agendamento> agendamentos;
-    std::vector<bool> visitados(imoveis.size(), false);
-    
-    double latAtual = corretor.latitude;
-    double lonAtual = corretor.longitude;
-    int tempoAtual = 0; // minutos desde 09:00
-    
-    int imoveisRestantes = corretor.imoveisAtribuidos.size();
-    
-    while (imoveisRestantes > 0) {
-        int proximoImovel = encontrarImovelMaisProximo(imoveis, corretor.imoveisAtribuidos, 
-                                                       visitados, latAtual, lonAtual);
-        
-        if (proximoImovel == -1) {
-            throw std::runtime_error("Erro: não foi possível encontrar próximo imóvel");
-        }
-        
-        // Calcular tempo de deslocamento
-        double distancia = haversine(latAtual, lonAtual, 
-                                   imoveis[proximoImovel - 1].latitude, 
-                                   imoveis[proximoImovel - 1].longitude);
-        int tempoDeslocamento = static_cast<int>(distancia * TEMPO_DESLOCAMENTO_POR_KM);
-        
-        // Atualizar tempo atual
-        tempoAtual += tempoDeslocamento;
-        
-        // Criar agendamento
-        auto [hora, minuto] = minutosParaHoraMinuto(tempoAtual);
-        agendamentos.emplace_back(hora, minuto, proximoImovel);
-        
-        // Atualizar posição atual
-        latAtual = imoveis[proximoImovel - 1].latitude;
-        lonAtual = imoveis[proximoImovel - 1].longitude;
-        
-        // Marcar como visitado
-        visitados[proximoImovel - 1] = true;
-        imoveisRestantes--;
-        
-        // Adicionar tempo da avaliação
-        tempoAtual += DURACAO_AVALIACAO;
-    }
-    
-    return agendamentos;
-}
-
-/**
- * Valida se um número está dentro de um intervalo válido
- */
-bool validarIntervalo(double valor, double min, double max, const std::string& nome) {
-    if (valor < min || valor > max) {
-        std::cerr << "Erro: " << nome << " deve estar entre " << min << " e " << max << std::endl;
-        return false;
-    }
-    return true;
-}
-
-/**
- * Lê e valida os dados de entrada
- */
-void lerDados(std::vector<Corretor>& corretores, 
-              std::vector<Cliente>& clientes, 
-              std::vector<Imovel>& imoveis) {
-    
-    // Ler corretores
-    int numCorretores;
-    if (!(std::cin >> numCorretores) || numCorretores <= 0) {
-        throw std::runtime_error("Erro: número de corretores inválido");
-    }
-    
-    for (int i = 0; i < numCorretores; ++i) {
-        std::string telefone;
-        int avaliador;
-        double lat, lon;
-        
-        if (!(std::cin >> telefone >> avaliador >> lat >> lon)) {
-            throw std::runtime_error("Erro: dados do corretor " + std::to_string(i + 1) + " inválidos");
-        }
-        
-        // Validar dados
-        if (avaliador != 0 && avaliador != 1) {
-            throw std::runtime_error("Erro: avaliador deve ser 0 ou 1");
+int main(int argc, char* argv[]) {
+    try {
+        Opcoes opcoes = lerOpcoes(argc, argv);
+        std::unique_ptr<RedeViaria> rede;
+        if (!opcoes.arquivoRede.empty()) {
+            auto inicioRede = std::chrono::steady_clock::now();
+            rede = std::make_unique<RedeViaria>(opcoes.arquivoRede);
+            opcoes.rota.rede = rede.get();
+            std::cerr << "Rede viária: " << rede->numNos() << " nós, " << rede->numArestas() << " arestas, "
+                      << rede->numAtalhos() << " atalhos, pré-processamento " << std::fixed << std::setprecision(0)
+                      << milissegundosDesde(inicioRede) << " ms" << std::endl;
         }
-        if (!validarIntervalo(lat, -90.0, 90.0, "latitude")) {
-            throw std::runtime_error("Erro: latitude inválida");
+        if (!opcoes.manifestoLote.empty()) {
+            return executarLote(opcoes);
         }
-        if (!validarIntervalo(lon, -180.0, 180.0, "longitude")) {
-            throw std::runtime_error("Erro: longitude inválida");
+        if (opcoes.esteira) {
+            return executarEsteira(opcoes);
         }
+        auto inicioExecucao = std::chrono::steady_clock::now();
         
-        std::string nome;
-        std::getline(std::cin >> std::ws, nome);
+        std::vector<Corretor> corretores;
+        std::vector<Cliente> clientes;
+        std::vector<Imovel> imoveis;
+        ArenaTextos textos;
         
-        if (nome.empty()) {
-            throw std::runtime_error("Erro: nome do corretor não pode estar vazio");
+        // Ler e validar dados de entrada (texto na entrada padrão ou snapshot binário);
+        // só o snapshot exportado precisa dos textos e dos clientes
+        ProjecaoBase projecao = opcoes.exportarSnapshot.empty() ? ProjecaoBase::Rotas : ProjecaoBase::Completa;
+        int numClientes = 0;
+        if (!opcoes.carregarSnapshot.empty()) {
+            carregarSnapshot(opcoes.carregarSnapshot, corretores, clientes, imoveis, textos);
+            numClientes = static_cast<int>(clientes.size());
+        } else if (!opcoes.arquivoEntrada.empty()) {
+            LeitorEntrada entrada(opcoes.arquivoEntrada);
+            numClientes = lerDados(entrada, corretores, clientes, imoveis, textos, projecao);
+        } else {
+            LeitorEntrada entrada(0);
+            numClientes = lerDados(entrada, corretores, clientes, imoveis, textos, projecao);
         }
         
-        corretores.emplace_back(telefone, avaliador == 1, lat, lon, nome);
-    }
-    
-    // Ler clientes
-    int numClientes;
-    if (!(std::cin >> numClientes) || numClientes < 0) {
-        throw std::runtime_error("Erro: número de clientes inválido");
-    }
-    
-    for (int i = 0; i < numClientes; ++i) {
-        std::string telefone;
-        if (!(std::cin >> telefone)) {
-            throw std::runtime_error("Erro: telefone do cliente " + std::to_string(i + 1) + " inválido");
+        // Base em ordem da curva de Hilbert (--reorder=hilbert); a saída volta aos IDs da entrada
+        if (opcoes.reordenarBase) {
+            reordenarPelaCurva(imoveis);
         }
         
-        std::string nome;
-        std::getline(std::cin >> std::ws, nome);
+        RelatorioMetricas metricas;
+        metricas.leituraMs = milissegundosDesde(inicioExecucao);
         
-        if (nome.empty()) {
-            throw std::runtime_error("Erro: nome do cliente não pode estar vazio");
+        if (!opcoes.exportarSnapshot.empty()) {
+            exportarSnapshot(opcoes.exportarSnapshot, corretores, clientes, imoveis);
+            return 0;
         }
         
-        clientes.emplace_back(telefone, nome);
-    }
-    
-    // Ler imóveis
-    int numImoveis;
-    if (!(std::cin >> numImoveis) || numImoveis <= 0) {
-        throw std::runtime_error("Erro: número de imóveis inválido");
-    }
-    
-    for (int i = 0; i < numImoveis; ++i) {
-        std::string tipo;
-        int propId;
-        double lat, lon, preco;
+        // Filtrar apenas corretores avaliadores (erro se não houver avaliadores ou imóveis)
+        std::vector<const Corretor*> avaliadores = selecionarAvaliadores(corretores, imoveis);
         
-        if (!(std::cin >> tipo >> propId >> lat >> lon >> preco)) {
-            throw std::runtime_error("Erro: dados do imóvel " + std::to_string(i + 1) + " inválidos");
+        // Checkpoint (--checkpoint, --resume): a atribuição e as rotas gravadas não são refeitas
+        std::uint64_t assinatura = 0;
+        EstadoCheckpoint retomado;
+        bool retomando = false;
+        if (!opcoes.arquivoCheckpoint.empty()) {
+            assinatura = assinaturaExecucao(corretores, imoveis, opcoes);
+            if (opcoes.retomar) {
+                retomando = carregarCheckpoint(opcoes.arquivoCheckpoint, assinatura, avaliadores,
+                                               static_cast<int>(imoveis.size()), retomado);
+            }
+            if (retomando) {
+                int prontas = static_cast<int>(std::count(retomado.prontas.begin(), retomado.prontas.end(), 1));
+                std::cerr << "Checkpoint: retomando " << opcoes.arquivoCheckpoint << " ("
+                          << (retomado.etapa == EtapaRebalanceadas ? "rotas rebalanceadas" : "rotas") << ", "
+                          << prontas << " de " << retomado.prontas.size() << " prontas)" << std::endl;
+            }
         }
         
-        // Validar dados
-        if (propId <= 0 || propId > static_cast<int>(clientes.size())) {
-            throw std::runtime_error("Erro: ID do proprietário inválido");
-        }
-        if (!validarIntervalo(lat, -90.0, 90.0, "latitude")) {
-            throw std::runtime_error("Erro: latitude inválida");
-        }
-        if (!validarIntervalo(lon, -180.0, 180.0, "longitude")) {
-            throw std::runtime_error("Erro: longitude inválida");
+        // Distribuir imóveis (Round-Robin por padrão, ou por agrupamento espacial)
+        auto inicioFase = std::chrono::steady_clock::now();
+        Atribuicao atribuicao = retomando ? std::move(retomado.atribuicao)
+                                          : atribuirImoveis(imoveis, avaliadores, opcoes.atribuicao, opcoes.threads);
+        metricas.atribuicaoMs = milissegundosDesde(inicioFase);
+        
+        // Gerar os agendamentos (em paralelo com --threads); cada rota é
+        // independente e grava o resultado na posição do seu corretor
+        std::vector<const Corretor*> comImoveis;
+        std::vector<FaixaImoveis> imoveisDeCada;
+        std::vector<std::vector<Agendamento>> agendas;
+        std::vector<EstatisticasDistancia> usoDistancia;
+        EstatisticasDistancia usoTotal; // Todas as gerações das rotas (relatório de --distance)
+        std::unique_ptr<GravadorCheckpoint> gravador;
+        if (!opcoes.arquivoCheckpoint.empty()) {
+            gravador = std::make_unique<GravadorCheckpoint>(opcoes.arquivoCheckpoint, assinatura,
+                                                            opcoes.intervaloCheckpointMs);
         }
-        if (preco <= 0) {
-            throw std::runtime_error("Erro: preço deve ser positivo");
+        auto gerarRotas = [&](int etapa) {
+            comImoveis.clear();
+            imoveisDeCada.clear();
+            for (int k = 0; k < atribuicao.numAvaliadores(); ++k) {
+                if (!atribuicao.imoveisDe(k).vazia()) {
+                    comImoveis.push_back(atribuicao.avaliadores[k]);
+                    imoveisDeCada.push_back(atribuicao.imoveisDe(k));
+                }
+            }
+            // Com menos rotas que threads, as que sobram vão para a programação
+            // dinâmica do caminho ótimo (--exact-max)
+            opcoes.rota.threadsExato = std::max(1, opcoes.threads / std::max(1, static_cast<int>(comImoveis.size())));
+            agendas.assign(comImoveis.size(), {});
+            usoDistancia.assign(comImoveis.size(), {});
+            // Com --rebalance-ms, a segunda geração soma o seu custo ao da primeira
+            std::vector<MetricasCorretor> anteriores = std::move(metricas.porCorretor);
+            metricas.porCorretor.assign(comImoveis.size(), {});
+            std::vector<std::uint8_t> prontas(comImoveis.size(), 0);
+            if (retomando && retomado.etapa == etapa) {
+                prontas = retomado.prontas;
+                for (size_t i = 0; i < comImoveis.size(); ++i) {
+                    agendas[i] = std::move(retomado.agendas[i]);
+                }
+            }
+            if (gravador) {
+                gravador->iniciarEtapa(etapa, atribuicao, agendas, prontas);
+            }
+            executarEmParalelo(static_cast<int>(comImoveis.size()), opcoes.threads, [&](int i) {
+                MetricasCorretor& metricasRota = metricas.porCorretor[i];
+                metricasRota.id = comImoveis[i]->id;
+                metricasRota.imoveis = static_cast<int>(imoveisDeCada[i].tamanho());
+                if (prontas[i]) {
+                    return;
+                }
+                ContadoresMetricas antes = contadoresDaThread;
+                {
+                    METRICA_TEMPORIZAR(metricasRota.rotaMs);
+                    agendas[i] = gerarAgendamentoCorretor(imoveis, *comImoveis[i], imoveisDeCada[i], opcoes.rota,
+                                                          &usoDistancia[i]);
+                }
+                metricasRota.contadores = contadoresDaThread - antes;
+                if (gravador) {
+                    gravador->rotaPronta(i);
+                }
+            });
+            if (gravador) {
+                gravador->encerrarEtapa();
+            }
+            somarPorCorretor(metricas.porCorretor, anteriores);
+            for (const auto& uso : usoDistancia) {
+                usoTotal += uso;
+            }
+        };
+        inicioFase = std::chrono::steady_clock::now();
+        bool rebalanceadas = retomando && retomado.etapa == EtapaRebalanceadas;
+        if (!rebalanceadas) {
+            gerarRotas(EtapaRotas);
         }
         
-        std::string endereco;
-        std::getline(std::cin >> std::ws, endereco);
-        
-        if (endereco.empty()) {
-            throw std::runtime_error("Erro: endereço não pode estar vazio");
+        // Paradas da primeira geração (a do rebalanceamento mantém a ordem, sem agrupar)
+        EstatisticasDistancia usoParadas;
+        for (const auto& uso : usoDistancia) {
+            usoParadas += uso;
         }
         
-        imoveis.emplace_back(Imovel::stringToTipo(tipo), propId, lat, lon, preco, endereco);
-    }
-}
-
-/**
- * Função principal do programa
- */
-int main() {
-    try {
-        std::vector<Corretor> corretores;
-        std::vector<Cliente> clientes;
-        std::vector<Imovel> imoveis;
-        
-        // Ler e validar dados de entrada
-        lerDados(corretores, clientes, imoveis);
-        
-        // Filtrar apenas corretores avaliadores
-        std::vector<Corretor*> avaliadores;
-        for (auto& corretor : corretores) {
-            if (corretor.isAvaliador()) {
-                avaliadores.push_back(&corretor);
+        // Otimização entre rotas (--rebalance-ms): imóveis mudam de avaliador
+        // e as rotas são agendadas na ordem encontrada
+        if (rebalanceadas) {
+            opcoes.rota.manterOrdem = true;
+            gerarRotas(EtapaRebalanceadas);
+            std::cerr << "Rebalanceamento: retomado do checkpoint" << std::endl;
+        } else if (opcoes.rebalanceamento.limiteMs > 0) {
+            auto inicioRebalanceamento = std::chrono::steady_clock::now();
+            std::vector<std::vector<int>> rotas(atribuicao.numAvaliadores());
+            int terminoAntes = 0;
+            for (size_t i = 0, k = 0; i < comImoveis.size(); ++i) {
+                while (atribuicao.avaliadores[k] != comImoveis[i]) {
+                    ++k;
+                }
+                for (const Agendamento& visita : agendas[i]) {
+                    rotas[k].push_back(visita.imovelId);
+                }
+                terminoAntes = std::max(terminoAntes, terminoAgenda(imoveis, agendas[i], opcoes.rota.tempo));
+            }
+            ResultadoRebalanceamento resultado = rebalancearRotas(imoveis, atribuicao.avaliadores, rotas,
+                                                                  opcoes.rota.tempo, opcoes.rebalanceamento,
+                                                                  opcoes.threads);
+            atribuicao = std::move(resultado.atribuicao);
+            opcoes.rota.manterOrdem = true;
+            gerarRotas(EtapaRebalanceadas);
+            int terminoDepois = 0;
+            for (const auto& agenda : agendas) {
+                terminoDepois = std::max(terminoDepois, terminoAgenda(imoveis, agenda, opcoes.rota.tempo));
             }
+            std::ios_base::fmtflags formato = std::cerr.flags();
+            std::streamsize precisao = std::cerr.precision();
+            std::cerr << "Rebalanceamento: última visita termina " << terminoAntes << " -> " << terminoDepois
+                      << " min após 09:00, " << resultado.rodadas << "/" << opcoes.rebalanceamento.rodadas
+                      << " rodadas" << (resultado.interrompida ? " (interrompido pelo limite de tempo)" : "")
+                      << ", " << std::fixed << std::setprecision(0) << milissegundosDesde(inicioRebalanceamento)
+                      << " ms" << std::endl;
+            std::cerr.flags(formato);
+            std::cerr.precision(precisao);
         }
+        metricas.rotasMs = milissegundosDesde(inicioFase);
         
-        // Verificar se há avaliadores
-        if (avaliadores.empty()) {
-            throw std::runtime_error("Erro: não há corretores avaliadores");
+        // Imprimir agendamentos na ordem dos IDs dos corretores
+        inicioFase = std::chrono::steady_clock::now();
+        {
+            EscritorAgenda escritor(opcoes.formato);
+            std::vector<Agendamento> comIdsDaEntrada;
+            for (size_t i = 0; i < comImoveis.size(); ++i) {
+                if (opcoes.reordenarBase) {
+                    comIdsDaEntrada = agendas[i];
+                    for (Agendamento& visita : comIdsDaEntrada) {
+                        visita.imovelId = imoveis[visita.imovelId - 1].id;
+                    }
+                    escritor.escreverCorretor(comImoveis[i]->id, comIdsDaEntrada);
+                } else {
+                    escritor.escreverCorretor(comImoveis[i]->id, agendas[i]);
+                }
+            }
+            escritor.finalizar();
+        }
+        if (gravador) {
+            gravador->concluir();
         }
+        metricas.saidaMs = milissegundosDesde(inicioFase);
+        metricas.totalMs = milissegundosDesde(inicioExecucao);
+        metricas.imoveis = imoveis.size();
+        metricas.corretores = corretores.size();
+        metricas.avaliadores = avaliadores.size();
+        metricas.threads = opcoes.threads;
+        metricas.contadores = contadoresDaThread;
+        metricas.picoMemoriaKb = picoMemoriaResidenteKb();
+        metricas.bytesTextos = textos.bytesUsados();
         
-        // Verificar se há imóveis para avaliar
-        if (imoveis.empty()) {
-            throw std::runtime_error("Erro: não há imóveis para avaliar");
+        if (opcoes.relatarTempos) {
+            escreverTemposJson(std::cerr,
+                               {{"imoveis", metricas.imoveis},
+                                {"corretores", metricas.corretores},
+                                {"avaliadores", metricas.avaliadores},
+                                {"threads", static_cast<std::size_t>(metricas.threads)}},
+                               {{"leitura_ms", metricas.leituraMs},
+                                {"atribuicao_ms", metricas.atribuicaoMs},
+                                {"rotas_ms", metricas.rotasMs},
+                                {"saida_ms", metricas.saidaMs},
+                                {"total_ms", metricas.totalMs}});
+        }
+        if (opcoes.relatarMetricas) {
+            publicarMetricas(metricas, opcoes.arquivoMetricas, std::cerr);
         }
         
-        // Distribuir imóveis (Round-Robin)
-        for (int i = 0; i < static_cast<int>(imoveis.size()); ++i) {
-            int avaliadorIndex = i % avaliadores.size();
-            avaliadores[avaliadorIndex]->adicionarImovel(imoveis[i].id);
+        double totalKm = 0.0;
+        if (opcoes.relatarDistancia) {
+            for (size_t i = 0; i < comImoveis.size(); ++i) {
+                totalKm += distanciaPercorrida(imoveis, *comImoveis[i], agendas[i]);
+            }
         }
+        relatarRotas(std::cerr, opcoes, totalKm, usoTotal, usoParadas);
         
-        // Gerar e imprimir agendamentos
-        bool primeiro = true;
-        for (const auto& corretor : corretores) {
-            if (corretor.isAvaliador() && !corretor.imoveisAtribuidos.empty()) {
-                if (!primeiro) {
-                    std::cout << std::endl;
-                }
-                primeiro = false;
-                
-                std::cout << "Corretor " << corretor.id << std::endl;
-                
-                std::vector<Agendamento> agendamentos = gerarAgendamentoCorretor(imoveis, corretor);
-                
-                for (const auto& agendamento : agendamentos) {
-                    std::cout << std::setfill('0') << std::setw(2) << agendamento.hora << ":"
-                              << std::setw(2) << agendamento.minuto << " Imóvel " 
-                              << agendamento.imovelId << std::endl;
+        // Modo serviço: as rotas geradas passam a ser mantidas incrementalmente
+        if (opcoes.servico) {
+            std::cout << std::endl;
+            std::vector<std::vector<int>> rotas(corretores.size());
+            for (size_t i = 0; i < comImoveis.size(); ++i) {
+                std::vector<int>& rota = rotas[comImoveis[i]->id - 1];
+                for (const Agendamento& visita : agendas[i]) {
+                    rota.push_back(visita.imovelId);
                 }
             }
+            AgendaIncremental agenda(std::move(corretores), std::move(rotas), std::move(imoveis), std::move(textos),
+                                     opcoes.rota);
+            executarServico(agenda, numClientes, opcoes.socketServico);
         }
         
     } catch (const std::exception& e) {
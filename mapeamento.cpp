@@ -0,0 +1,140 @@
+/**
+ * @file mapeamento.cpp
+ * @brief Implementação do acesso ao conteúdo completo de um arquivo
+ * 
+ * Em sistemas POSIX, arquivos regulares são mapeados com mmap; pipes e
+ * terminais são lidos com read() em blocos de 1 MiB. Em outros sistemas a
+ * leitura em blocos usa std::fread.
+ */
+
+#include "mapeamento.h"
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPEAMENTO_POSIX 1
+#endif
+
+namespace {
+
+constexpr std::size_t TAMANHO_BLOCO = 1 << 20; // Leitura em blocos de 1 MiB
+
+} // namespace
+
+/**
+ * @brief Carrega o conteúdo a partir da posição atual do descritor
+ */
+ArquivoMapeado::ArquivoMapeado(int fd) {
+    carregar(fd);
+}
+
+/**
+ * @brief Abre e carrega o arquivo indicado
+ */
+ArquivoMapeado::ArquivoMapeado(const std::string& caminho) {
+#ifdef MAPEAMENTO_POSIX
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Erro: não foi possível abrir " + caminho);
+    }
+    carregar(fd);
+    close(fd);
+#else
+    std::FILE* arquivo = std::fopen(caminho.c_str(), "rb");
+    if (!arquivo) {
+        throw std::runtime_error("Erro: não foi possível abrir " + caminho);
+    }
+    std::size_t usados = 0;
+    for (;;) {
+        buffer.resize(usados + TAMANHO_BLOCO);
+        std::size_t lidos = std::fread(buffer.data() + usados, 1, TAMANHO_BLOCO, arquivo);
+        usados += lidos;
+        if (lidos < TAMANHO_BLOCO) {
+            break;
+        }
+    }
+    std::fclose(arquivo);
+    buffer.resize(usados);
+    inicio = buffer.data();
+    tamanhoDados = usados;
+#endif
+}
+
+ArquivoMapeado::~ArquivoMapeado() {
+#ifdef MAPEAMENTO_POSIX
+    if (mapeado) {
+        munmap(mapeado, tamanhoMapeado);
+    }
+#endif
+}
+
+/**
+ * @brief Devolve ao sistema as páginas mapeadas inteiramente antes de posicao
+ */
+void ArquivoMapeado::descartarAte(const char* posicao) {
+#ifdef MAPEAMENTO_POSIX
+    if (!mapeado) {
+        return;
+    }
+    std::size_t pagina = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t limite = static_cast<std::size_t>(posicao - static_cast<const char*>(mapeado)) / pagina * pagina;
+    if (limite > tamanhoDescartado) {
+        madvise(static_cast<char*>(mapeado) + tamanhoDescartado, limite - tamanhoDescartado, MADV_DONTNEED);
+        tamanhoDescartado = limite;
+    }
+#else
+    (void)posicao;
+#endif
+}
+
+/**
+ * @brief Tenta mapear o descritor; se não for um arquivo regular, lê em blocos
+ */
+void ArquivoMapeado::carregar(int fd) {
+#ifdef MAPEAMENTO_POSIX
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        off_t posicao = lseek(fd, 0, SEEK_CUR);
+        void* regiao = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (regiao != MAP_FAILED && posicao >= 0 && posicao <= info.st_size) {
+            madvise(regiao, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapeado = regiao;
+            tamanhoMapeado = static_cast<std::size_t>(info.st_size);
+            inicio = static_cast<const char*>(regiao) + posicao;
+            tamanhoDados = tamanhoMapeado - static_cast<std::size_t>(posicao);
+            return;
+        }
+        if (regiao != MAP_FAILED) {
+            munmap(regiao, static_cast<std::size_t>(info.st_size));
+        }
+    }
+
+    std::size_t usados = 0;
+    for (;;) {
+        buffer.resize(usados + TAMANHO_BLOCO);
+        ssize_t lidos = read(fd, buffer.data() + usados, TAMANHO_BLOCO);
+        if (lidos <= 0) {
+            break;
+        }
+        usados += static_cast<std::size_t>(lidos);
+    }
+#else
+    std::FILE* arquivo = (fd == 0) ? stdin : nullptr;
+    std::size_t usados = 0;
+    while (arquivo) {
+        buffer.resize(usados + TAMANHO_BLOCO);
+        std::size_t lidos = std::fread(buffer.data() + usados, 1, TAMANHO_BLOCO, arquivo);
+        usados += lidos;
+        if (lidos < TAMANHO_BLOCO) {
+            break;
+        }
+    }
+#endif
+    buffer.resize(usados);
+    inicio = buffer.data();
+    tamanhoDados = usados;
+}
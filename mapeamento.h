@@ -0,0 +1,70 @@
+/**
+ * @file mapeamento.h
+ * @brief Acesso somente leitura ao conteúdo completo de um arquivo
+ * 
+ * Mapeia o arquivo com mmap quando possível e, caso contrário (pipes,
+ * terminais, sistemas sem mmap), lê tudo em blocos grandes para memória.
+ * É usado pelo leitor da entrada texto e pelo carregamento de snapshots.
+ */
+
+#ifndef MAPEAMENTO_H
+#define MAPEAMENTO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class ArquivoMapeado
+ * @brief Conteúdo de um arquivo disponível como um bloco contíguo de bytes
+ */
+class ArquivoMapeado {
+public:
+    /**
+     * @brief Cria um arquivo vazio (usado quando o texto já está em memória)
+     */
+    ArquivoMapeado() = default;
+
+    /**
+     * @brief Carrega o conteúdo a partir da posição atual do descritor
+     * @param fd Descritor de arquivo (por exemplo, 0 para a entrada padrão)
+     */
+    explicit ArquivoMapeado(int fd);
+
+    /**
+     * @brief Abre e carrega o arquivo indicado
+     * @param caminho Caminho do arquivo
+     * @throws std::runtime_error se o arquivo não puder ser aberto
+     */
+    explicit ArquivoMapeado(const std::string& caminho);
+
+    ~ArquivoMapeado();
+
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+    const char* dados() const { return inicio; }
+    std::size_t tamanho() const { return tamanhoDados; }
+
+    /**
+     * @brief Devolve ao sistema as páginas mapeadas inteiramente antes de posicao
+     * 
+     * Reduz a memória residente de quem percorre o arquivo uma única vez.
+     * Se algo antes de posicao for lido de novo, o conteúdo volta do disco.
+     * Não faz nada quando o conteúdo foi lido para memória.
+     */
+    void descartarAte(const char* posicao);
+
+private:
+    const char* inicio = nullptr;
+    std::size_t tamanhoDados = 0;
+
+    void* mapeado = nullptr;          ///< Região mapeada com mmap (se usada)
+    std::size_t tamanhoMapeado = 0;
+    std::size_t tamanhoDescartado = 0; ///< Bytes iniciais da região já devolvidos
+    std::vector<char> buffer;         ///< Dados lidos em blocos (se mmap não foi possível)
+
+    void carregar(int fd);
+};
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file melhoria.cpp
+ * @brief Implementação da busca local 2-opt / Or-opt
+ * 
+ * Representação: nó 0 é a localização do corretor e o nó p + 1 é o imóvel
+ * na posição p do bloco. O vetor "tour" guarda os nós na ordem de visita
+ * (tour[0] = 0, fixo). Depois do último imóvel há um fim virtual com
+ * distância zero, o que transforma o caminho aberto num caso do 2-opt usual.
+ */
+
+#include "melhoria.h"
+#include "indice_espacial.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace {
+
+constexpr int NUM_VIZINHOS = 8;      // Tamanho das listas de vizinhos
+constexpr int MAX_SEGMENTO = 3;      // Maior trecho movido pelo Or-opt
+constexpr double GANHO_MINIMO = 1e-9; // Ganho (km) abaixo disso é ignorado
+constexpr int FIM = -1;              // Nó virtual após o último imóvel
+
+/**
+ * Estado da busca local sobre uma rota
+ */
+class BuscaLocal {
+public:
+    BuscaLocal(const BlocoCoordenadas& pontos, const std::vector<int>& rota, ProvedorDistancia& provedor)
+        : n(static_cast<int>(rota.size())), provedor(provedor) {
+        tour.resize(n + 1);
+        posicao.resize(n + 1);
+        tour[0] = 0;
+        for (int i = 0; i < n; ++i) {
+            tour[i + 1] = rota[i] + 1;
+        }
+        for (int i = 0; i <= n; ++i) {
+            posicao[tour[i]] = i;
+        }
+
+        // Listas de vizinhos pelo índice espacial (excluindo o próprio ponto)
+        IndiceEspacial indice(pontos);
+        int k = std::min(NUM_VIZINHOS, n - 1);
+        vizinhos.assign(static_cast<size_t>(n + 1) * k, 0);
+        quantosVizinhos = k;
+        std::vector<int> proximos;
+        std::vector<double> distancias;
+        for (int p = 0; p < n; ++p) {
+            indice.kMaisProximos(pontos.latitude[p], pontos.longitude[p], k + 1, proximos, distancias);
+            int preenchidos = 0;
+            for (int q : proximos) {
+                if (q != p && preenchidos < k) {
+                    vizinhos[static_cast<size_t>(p + 1) * k + preenchidos++] = q + 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * Executa a busca até esgotar as melhorias ou o tempo
+     */
+    void executar(std::chrono::steady_clock::time_point prazo) {
+        std::deque<int> fila;
+        std::vector<char> naFila(n + 1, 0);
+        for (int i = 1; i <= n; ++i) {
+            fila.push_back(tour[i]);
+            naFila[tour[i]] = 1;
+        }
+        auto ativar = [&](int no) {
+            if (no > 0 && !naFila[no]) {
+                naFila[no] = 1;
+                fila.push_back(no);
+            }
+        };
+
+        int passos = 0;
+        while (!fila.empty()) {
+            if (++passos % 64 == 0 && std::chrono::steady_clock::now() >= prazo) {
+                break;
+            }
+            int a = fila.front();
+            fila.pop_front();
+            naFila[a] = 0;
+
+            std::vector<int> afetados;
+            if (tentarDoisOpt(a, afetados) || tentarOrOpt(a, afetados)) {
+                ativar(a);
+                for (int no : afetados) {
+                    ativar(no);
+                }
+            }
+        }
+    }
+
+    /**
+     * Rota resultante, em posições do bloco
+     */
+    std::vector<int> rota() const {
+        std::vector<int> resultado(n);
+        for (int i = 0; i < n; ++i) {
+            resultado[i] = tour[i + 1] - 1;
+        }
+        return resultado;
+    }
+
+private:
+    int n;
+    ProvedorDistancia& provedor;
+    std::vector<int> tour;
+    std::vector<int> posicao;
+    std::vector<int> vizinhos;
+    int quantosVizinhos = 0;
+
+    double d(int u, int v) const {
+        if (u == FIM || v == FIM) {
+            return 0.0;
+        }
+        return provedor.distancia(u, v);
+    }
+
+    int sucessor(int i) const {
+        return i < n ? tour[i + 1] : FIM;
+    }
+
+    /**
+     * Ganho do 2-opt que troca (tour[i], tour[i+1]) e (tour[j], suc(j))
+     * por (tour[i], tour[j]) e (tour[i+1], suc(j)), com 0 <= i < j <= n
+     */
+    double ganhoDoisOpt(int i, int j) const {
+        if (i < 0 || j - i < 2) {
+            return 0.0;
+        }
+        int a = tour[i], b = tour[i + 1], c = tour[j], e = sucessor(j);
+        return d(a, b) + d(c, e) - d(a, c) - d(b, e);
+    }
+
+    void aplicarDoisOpt(int i, int j, std::vector<int>& afetados) {
+        afetados.insert(afetados.end(), {tour[i], tour[i + 1], tour[j]});
+        if (j < n) {
+            afetados.push_back(tour[j + 1]);
+        }
+        std::reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+        for (int k = i + 1; k <= j; ++k) {
+            posicao[tour[k]] = k;
+        }
+    }
+
+    /**
+     * 2-opt a partir do nó a com cada vizinho c, nas variantes "sucessor"
+     * (arestas que saem de a e c) e "antecessor" (arestas que chegam a eles)
+     */
+    bool tentarDoisOpt(int a, std::vector<int>& afetados) {
+        int pa = posicao[a];
+        double dSuc = d(a, sucessor(pa));
+        double dAnt = d(tour[pa - 1], a);
+        for (int v = 0; v < quantosVizinhos; ++v) {
+            int c = vizinhos[static_cast<size_t>(a) * quantosVizinhos + v];
+            double dac = d(a, c);
+            if (dac >= dSuc && dac >= dAnt) {
+                break; // vizinhos em ordem crescente: nenhum outro pode ganhar
+            }
+            int pc = posicao[c];
+            int i = std::min(pa, pc), j = std::max(pa, pc);
+            if (dac < dSuc && ganhoDoisOpt(i, j) > GANHO_MINIMO) {
+                aplicarDoisOpt(i, j, afetados);
+                return true;
+            }
+            if (dac < dAnt && ganhoDoisOpt(i - 1, j - 1) > GANHO_MINIMO) {
+                aplicarDoisOpt(i - 1, j - 1, afetados);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Or-opt: move o trecho de 1 a 3 imóveis que começa em a para junto de
+     * um vizinho, na orientação original ou invertida
+     */
+    bool tentarOrOpt(int a, std::vector<int>& afetados) {
+        int i = posicao[a];
+        for (int tamanho = 1; tamanho <= MAX_SEGMENTO && i + tamanho - 1 <= n; ++tamanho) {
+            int fimSeg = i + tamanho - 1;
+            int s1 = tour[i], sL = tour[fimSeg];
+            int antes = tour[i - 1], depois = sucessor(fimSeg);
+            double ganhoRemocao = d(antes, s1) + d(sL, depois) - d(antes, depois);
+            if (ganhoRemocao <= GANHO_MINIMO) {
+                continue;
+            }
+
+            for (int v = 0; v < quantosVizinhos; ++v) {
+                int c = vizinhos[static_cast<size_t>(a) * quantosVizinhos + v];
+                int pc = posicao[c];
+                if (pc >= i && pc <= fimSeg) {
+                    continue;
+                }
+                // Inserir entre tour[q] e tour[q+1], para q = pc (depois de c) e q = pc - 1 (antes de c)
+                for (int q : {pc, pc - 1}) {
+                    if (q >= i - 1 && q <= fimSeg) {
+                        continue; // posição original do trecho
+                    }
+                    int x = tour[q], y = sucessor(q);
+                    double base = d(x, y);
+                    double direto = d(x, s1) + d(sL, y) - base;
+                    double invertido = d(x, sL) + d(s1, y) - base;
+                    bool inverter = invertido < direto;
+                    double custo = inverter ? invertido : direto;
+                    if (ganhoRemocao - custo > GANHO_MINIMO) {
+                        aplicarOrOpt(i, tamanho, q, inverter, afetados);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    void aplicarOrOpt(int i, int tamanho, int q, bool inverter, std::vector<int>& afetados) {
+        int fimSeg = i + tamanho - 1;
+        afetados.insert(afetados.end(), {tour[i - 1], tour[q], tour[i], tour[fimSeg]});
+        if (fimSeg < n) afetados.push_back(tour[fimSeg + 1]);
+        if (q < n) afetados.push_back(tour[q + 1]);
+
+        int primeiro, ultimo, inicioSeg;
+        if (q > fimSeg) {
+            std::rotate(tour.begin() + i, tour.begin() + fimSeg + 1, tour.begin() + q + 1);
+            primeiro = i;
+            ultimo = q;
+            inicioSeg = q - tamanho + 1;
+        } else {
+            std::rotate(tour.begin() + q + 1, tour.begin() + i, tour.begin() + fimSeg + 1);
+            primeiro = q + 1;
+            ultimo = fimSeg;
+            inicioSeg = q + 1;
+        }
+        if (inverter) {
+            std::reverse(tour.begin() + inicioSeg, tour.begin() + inicioSeg + tamanho);
+        }
+        for (int k = primeiro; k <= ultimo; ++k) {
+            posicao[tour[k]] = k;
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Melhora a ordem das visitas com 2-opt e Or-opt
+ * 
+ * Rotas com menos de 3 imóveis já são ótimas para esses movimentos.
+ */
+void melhorarRota(const BlocoCoordenadas& pontos, std::vector<int>& rota, int limiteMs,
+                  ProvedorDistancia& provedor) {
+    if (rota.size() < 3 || limiteMs <= 0) {
+        return;
+    }
+    auto prazo = std::chrono::steady_clock::now() + std::chrono::milliseconds(limiteMs);
+    BuscaLocal busca(pontos, rota, provedor);
+    busca.executar(prazo);
+    rota = busca.rota();
+}
@@ -0,0 +1,33 @@
+/**
+ * @file melhoria.h
+ * @brief Busca local (2-opt e Or-opt) sobre a rota do vizinho mais próximo
+ * 
+ * Etapa opcional, ligada por --improve-ms: a rota gulosa costuma ficar
+ * 20–25% mais longa do que um ótimo local. A rota é um caminho aberto que
+ * começa na localização do corretor e termina no último imóvel.
+ */
+
+#ifndef MELHORIA_H
+#define MELHORIA_H
+
+#include <vector>
+#include "coordenadas.h"
+#include "distancia.h"
+
+/**
+ * @brief Melhora a ordem das visitas com 2-opt e Or-opt até não haver ganho ou o tempo acabar
+ * 
+ * Usa listas com os vizinhos mais próximos de cada imóvel e bits de
+ * "não olhar": só imóveis cujas arestas mudaram voltam a ser examinados,
+ * então cada passada custa proporcionalmente ao número de mudanças e não a
+ * n². A reversão de um trecho no 2-opt custa o tamanho do trecho.
+ * 
+ * @param pontos Coordenadas dos imóveis do corretor (usadas nas listas de vizinhos)
+ * @param rota Posições (em pontos) na ordem de visita; é alterada no lugar
+ * @param limiteMs Tempo máximo de parede, em milissegundos
+ * @param provedor Provedor de distâncias da rota (nó 0 = corretor)
+ */
+void melhorarRota(const BlocoCoordenadas& pontos, std::vector<int>& rota, int limiteMs,
+                  ProvedorDistancia& provedor);
+
+#endif
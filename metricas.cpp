@@ -0,0 +1,205 @@
+/**
+ * @file metricas.cpp
+ * @brief Implementação da soma de contadores, da saída JSON das métricas e dos resumos em stderr
+ */
+
+#include "metricas.h"
+#include "distancia.h"
+#include "opcoes.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include <sys/resource.h>
+
+ContadoresMetricas& ContadoresMetricas::operator+=(const ContadoresMetricas& outros) {
+    haversine += outros.haversine;
+    consultasVizinho += outros.consultasVizinho;
+    candidatosVizinho += outros.candidatosVizinho;
+    confirmacoesVizinho += outros.confirmacoesVizinho;
+    bytesLidos += outros.bytesLidos;
+    return *this;
+}
+
+ContadoresMetricas ContadoresMetricas::operator-(const ContadoresMetricas& outros) const {
+    ContadoresMetricas diferenca;
+    diferenca.haversine = haversine - outros.haversine;
+    diferenca.consultasVizinho = consultasVizinho - outros.consultasVizinho;
+    diferenca.candidatosVizinho = candidatosVizinho - outros.candidatosVizinho;
+    diferenca.confirmacoesVizinho = confirmacoesVizinho - outros.confirmacoesVizinho;
+    diferenca.bytesLidos = bytesLidos - outros.bytesLidos;
+    return diferenca;
+}
+
+/**
+ * @brief Soma a porCorretor o custo de uma geração anterior das rotas
+ */
+void somarPorCorretor(std::vector<MetricasCorretor>& porCorretor, const std::vector<MetricasCorretor>& anteriores) {
+    std::vector<MetricasCorretor> soma;
+    soma.reserve(porCorretor.size() + anteriores.size());
+    std::size_t i = 0, j = 0;
+    while (i < porCorretor.size() || j < anteriores.size()) {
+        if (j == anteriores.size() || (i < porCorretor.size() && porCorretor[i].id < anteriores[j].id)) {
+            soma.push_back(porCorretor[i++]);
+        } else if (i == porCorretor.size() || anteriores[j].id < porCorretor[i].id) {
+            soma.push_back(anteriores[j++]);
+        } else {
+            MetricasCorretor atual = porCorretor[i++];
+            atual.rotaMs += anteriores[j].rotaMs;
+            atual.contadores += anteriores[j++].contadores;
+            soma.push_back(atual);
+        }
+    }
+    porCorretor = std::move(soma);
+}
+
+/**
+ * @brief Pico de memória residente do processo (ru_maxrss, em KiB no Linux)
+ */
+long picoMemoriaResidenteKb() {
+    rusage uso{};
+    if (getrusage(RUSAGE_SELF, &uso) != 0) {
+        return 0;
+    }
+    return uso.ru_maxrss;
+}
+
+namespace {
+
+/**
+ * Campos dos contadores, sem as chaves do objeto
+ */
+void escreverContadores(std::ostream& saida, const ContadoresMetricas& c) {
+    double porConsulta = c.consultasVizinho > 0
+                             ? static_cast<double>(c.candidatosVizinho) / c.consultasVizinho
+                             : 0.0;
+    saida << "\"haversine\":" << c.haversine
+          << ",\"consultas_vizinho\":" << c.consultasVizinho
+          << ",\"candidatos_vizinho\":" << c.candidatosVizinho
+          << ",\"confirmacoes_vizinho\":" << c.confirmacoesVizinho
+          << ",\"candidatos_por_consulta\":" << porConsulta;
+}
+
+} // namespace
+
+/**
+ * @brief Escreve o relatório como um objeto JSON (uma linha)
+ *
+ * Formato (versão 1):
+ * {"versao":1,"metricas_compiladas":true,"imoveis":N,"corretores":N,
+ *  "avaliadores":N,"threads":N,
+ *  "fases":{"leitura_ms":..,"atribuicao_ms":..,"rotas_ms":..,"saida_ms":..,"total_ms":..},
+ *  "memoria":{"pico_rss_kb":..,"bytes_textos":..},
+ *  "contadores":{"bytes_lidos":..,"haversine":..,"consultas_vizinho":..,...},
+ *  "por_corretor":[{"id":..,"imoveis":..,"rota_ms":..,"haversine":..,...},...]}
+ */
+void escreverMetricasJson(std::ostream& saida, const RelatorioMetricas& r) {
+    std::ios_base::fmtflags formato = saida.flags();
+    std::streamsize precisao = saida.precision();
+    saida << std::fixed << std::setprecision(3);
+
+    saida << "{\"versao\":1"
+          << ",\"metricas_compiladas\":" << (metricasCompiladas() ? "true" : "false")
+          << ",\"imoveis\":" << r.imoveis
+          << ",\"corretores\":" << r.corretores
+          << ",\"avaliadores\":" << r.avaliadores
+          << ",\"threads\":" << r.threads
+          << ",\"fases\":{\"leitura_ms\":" << r.leituraMs
+          << ",\"atribuicao_ms\":" << r.atribuicaoMs
+          << ",\"rotas_ms\":" << r.rotasMs
+          << ",\"saida_ms\":" << r.saidaMs
+          << ",\"total_ms\":" << r.totalMs << "}"
+          << ",\"memoria\":{\"pico_rss_kb\":" << r.picoMemoriaKb
+          << ",\"bytes_textos\":" << r.bytesTextos << "}"
+          << ",\"contadores\":{\"bytes_lidos\":" << r.contadores.bytesLidos << ",";
+    escreverContadores(saida, r.contadores);
+    saida << "},\"por_corretor\":[";
+    for (std::size_t i = 0; i < r.porCorretor.size(); ++i) {
+        const MetricasCorretor& m = r.porCorretor[i];
+        saida << (i > 0 ? "," : "") << "{\"id\":" << m.id << ",\"imoveis\":" << m.imoveis
+              << ",\"rota_ms\":" << m.rotaMs << ",";
+        escreverContadores(saida, m.contadores);
+        saida << "}";
+    }
+    saida << "]}" << std::endl;
+
+    saida.flags(formato);
+    saida.precision(precisao);
+}
+
+/**
+ * @brief Escreve o relatório em saida ou, se caminho não for vazio, no arquivo
+ */
+void publicarMetricas(const RelatorioMetricas& relatorio, const std::string& caminho, std::ostream& saida) {
+    if (caminho.empty()) {
+        escreverMetricasJson(saida, relatorio);
+        return;
+    }
+    std::ofstream arquivo(caminho);
+    if (!arquivo) {
+        throw std::runtime_error("Erro: não foi possível criar " + caminho);
+    }
+    escreverMetricasJson(arquivo, relatorio);
+    if (!arquivo) {
+        throw std::runtime_error("Erro: falha ao gravar " + caminho);
+    }
+}
+
+/**
+ * @brief Escreve a linha JSON de --timings
+ */
+void escreverTemposJson(std::ostream& saida,
+                        std::initializer_list<std::pair<const char*, std::size_t>> contagens,
+                        std::initializer_list<std::pair<const char*, double>> tempos) {
+    std::ios_base::fmtflags formato = saida.flags();
+    std::streamsize precisao = saida.precision();
+    saida << std::fixed << std::setprecision(3);
+
+    const char* separador = "{";
+    for (const auto& campo : contagens) {
+        saida << separador << "\"" << campo.first << "\":" << campo.second;
+        separador = ",";
+    }
+    for (const auto& campo : tempos) {
+        saida << separador << "\"" << campo.first << "\":" << campo.second;
+        separador = ",";
+    }
+    saida << "}" << std::endl;
+
+    saida.flags(formato);
+    saida.precision(precisao);
+}
+
+/**
+ * @brief Escreve os resumos das rotas pedidos em opcoes
+ */
+void relatarRotas(std::ostream& saida, const Opcoes& opcoes, double totalKm,
+                  const EstatisticasDistancia& uso, const EstatisticasDistancia& paradas) {
+    std::ios_base::fmtflags formato = saida.flags();
+    std::streamsize precisao = saida.precision();
+
+    if (opcoes.relatarDistancia) {
+        saida << "Atribuição " << (opcoes.atribuicao == ModoAtribuicao::Cluster ? "cluster" : "roundrobin")
+              << ": distância total percorrida " << std::fixed << std::setprecision(2)
+              << totalKm << " km" << std::endl;
+    }
+    if (opcoes.relatarProvedor) {
+        double taxaAcerto = uso.consultas > 0 ? 100.0 * uso.acertos / uso.consultas : 0.0;
+        saida << "Distância " << nomeTipoDistancia(opcoes.rota.distancia)
+              << ": " << uso.consultas << " consultas, " << uso.acertos << " acertos ("
+              << std::fixed << std::setprecision(1) << taxaAcerto << "%), "
+              << uso.calculos << " cálculos" << std::endl;
+    }
+    if (opcoes.rota.raioParadasM >= 0.0) {
+        double porParada = paradas.paradas > 0 ? static_cast<double>(paradas.imoveis) / paradas.paradas : 0.0;
+        double reducao = paradas.imoveis > 0
+                             ? 100.0 * (1.0 - static_cast<double>(paradas.paradas) / paradas.imoveis)
+                             : 0.0;
+        saida << "Paradas: " << paradas.imoveis << " imóveis em " << paradas.paradas << " paradas ("
+              << std::fixed << std::setprecision(1) << porParada << " imóveis por parada, redução de "
+              << reducao << "%)" << std::endl;
+    }
+
+    saida.flags(formato);
+    saida.precision(precisao);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file metricas.h
+ * @brief Instrumentação de baixo custo: contadores por thread e temporizadores de escopo
+ *
+ * Os pontos quentes (haversine, busca do vizinho mais próximo, leitura)
+ * incrementam contadores de uma estrutura thread_local, sem atomics nem
+ * travas; quem quer o total de um trecho de código tira um retrato dos
+ * contadores antes e depois e subtrai (é assim que main atribui o custo de
+ * cada rota ao seu corretor, mesmo com --threads).
+ *
+ * Compilando com -DIMOBILIARIA_SEM_METRICAS (make METRICAS_FLAGS=...), as
+ * macros METRICA_* viram código vazio e os contadores ficam em zero.
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct EstatisticasDistancia;
+struct Opcoes;
+
+/**
+ * @struct ContadoresMetricas
+ * @brief Contadores dos pontos quentes, acumulados por thread
+ */
+struct ContadoresMetricas {
+    std::uint64_t haversine = 0;          ///< Chamadas da fórmula de Haversine
+    std::uint64_t consultasVizinho = 0;   ///< Consultas ao índice espacial
+    std::uint64_t candidatosVizinho = 0;  ///< Pontos das folhas examinados pelo kernel em lote
+    std::uint64_t confirmacoesVizinho = 0; ///< Candidatos que chegaram à distância exata
+    std::uint64_t bytesLidos = 0;         ///< Bytes da entrada consumidos pelo leitor
+
+    ContadoresMetricas& operator+=(const ContadoresMetricas& outros);
+    ContadoresMetricas operator-(const ContadoresMetricas& outros) const;
+};
+
+/// Contadores da thread atual
+inline thread_local ContadoresMetricas contadoresDaThread;
+
+#ifdef IMOBILIARIA_SEM_METRICAS
+#define METRICA_CONTAR(campo, quantidade) ((void)0)
+#define METRICA_TEMPORIZAR(destinoMs) ((void)0)
+#else
+#define METRICA_CONCATENAR_(a, b) a##b
+#define METRICA_CONCATENAR(a, b) METRICA_CONCATENAR_(a, b)
+/// Soma quantidade ao contador campo da thread atual
+#define METRICA_CONTAR(campo, quantidade) (contadoresDaThread.campo += (quantidade))
+/// Soma a duração do escopo atual (em ms) a destinoMs
+#define METRICA_TEMPORIZAR(destinoMs) \
+    TemporizadorEscopo METRICA_CONCATENAR(temporizador_, __LINE__)(destinoMs)
+#endif
+
+/**
+ * @brief Informa se a instrumentação foi compilada
+ */
+constexpr bool metricasCompiladas() {
+#ifdef IMOBILIARIA_SEM_METRICAS
+    return false;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Milissegundos decorridos desde o instante dado
+ */
+inline double milissegundosDesde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+/**
+ * @class TemporizadorEscopo
+ * @brief Soma a destino o tempo (ms) entre a construção e a destruição
+ */
+class TemporizadorEscopo {
+public:
+    explicit TemporizadorEscopo(double& destinoMs)
+        : destino(destinoMs), inicio(std::chrono::steady_clock::now()) {}
+
+    ~TemporizadorEscopo() {
+        destino += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    TemporizadorEscopo(const TemporizadorEscopo&) = delete;
+    TemporizadorEscopo& operator=(const TemporizadorEscopo&) = delete;
+
+private:
+    double& destino;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * @struct MetricasCorretor
+ * @brief Custo da geração da rota de um corretor
+ */
+struct MetricasCorretor {
+    int id = 0;
+    int imoveis = 0;
+    double rotaMs = 0.0;
+    ContadoresMetricas contadores;
+};
+
+/**
+ * @struct RelatorioMetricas
+ * @brief Tudo o que --metrics=json publica sobre uma execução
+ */
+struct RelatorioMetricas {
+    std::size_t imoveis = 0;
+    std::size_t corretores = 0;
+    std::size_t avaliadores = 0;
+    int threads = 1;
+    double leituraMs = 0.0;
+    double atribuicaoMs = 0.0;
+    double rotasMs = 0.0;
+    double saidaMs = 0.0;
+    double totalMs = 0.0;
+    long picoMemoriaKb = 0;                  ///< Pico de memória residente do processo (KiB)
+    std::size_t bytesTextos = 0;             ///< Bytes de nomes, telefones e endereços na arena
+    ContadoresMetricas contadores;           ///< Soma de todas as threads
+    std::vector<MetricasCorretor> porCorretor;
+};
+
+/**
+ * @brief Soma a porCorretor o custo de uma geração anterior das rotas
+ *
+ * Ambas as listas estão em ordem de ID. Corretores presentes nas duas têm
+ * tempos e contadores somados (imoveis fica o da geração atual); os que só
+ * aparecem em anteriores entram com os seus valores.
+ */
+void somarPorCorretor(std::vector<MetricasCorretor>& porCorretor, const std::vector<MetricasCorretor>& anteriores);
+
+/**
+ * @brief Pico de memória residente do processo até agora, em KiB (0 se indisponível)
+ */
+long picoMemoriaResidenteKb();
+
+/**
+ * @brief Escreve o relatório como um objeto JSON (uma linha)
+ * @param saida Stream de destino
+ * @param relatorio Métricas da execução
+ */
+void escreverMetricasJson(std::ostream& saida, const RelatorioMetricas& relatorio);
+
+/**
+ * @brief Escreve o relatório em saida ou, se caminho não for vazio, no arquivo
+ * @throws std::runtime_error se o arquivo não puder ser criado
+ */
+void publicarMetricas(const RelatorioMetricas& relatorio, const std::string& caminho, std::ostream& saida);
+
+/**
+ * @brief Escreve a linha JSON de --timings: primeiro as contagens, depois os tempos (ms, 3 casas)
+ *
+ * Cada modo (sequencial, --pipeline, --batch) tem as suas fases; os nomes
+ * dos campos vêm de quem chama, o formato é o mesmo para todos.
+ */
+void escreverTemposJson(std::ostream& saida,
+                        std::initializer_list<std::pair<const char*, std::size_t>> contagens,
+                        std::initializer_list<std::pair<const char*, double>> tempos);
+
+/**
+ * @brief Escreve os resumos das rotas pedidos em opcoes
+ *
+ * Distância total percorrida (--assign), uso do provedor (--distance) e
+ * agrupamento em paradas (--collapse-m), uma linha cada.
+ * @param totalKm Soma das distâncias percorridas por todas as rotas
+ * @param uso Contadores do provedor somados entre as rotas
+ * @param paradas Contadores de imóveis e paradas das rotas
+ */
+void relatarRotas(std::ostream& saida, const Opcoes& opcoes, double totalKm,
+                  const EstatisticasDistancia& uso, const EstatisticasDistancia& paradas);
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file opcoes.cpp
+ * @brief Implementação da leitura das opções de linha de comando
+ * 
+ * Cada opção aceita as formas "--opcao valor" e "--opcao=valor".
+ */
+
+#include "opcoes.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * Separa "--opcao=valor" em nome e valor; para "--opcao valor" consome o próximo argumento
+ */
+std::string valorDaOpcao(int argc, char* argv[], int& i, const std::string& nome) {
+    std::string arg = argv[i];
+    if (arg.size() > nome.size() && arg[nome.size()] == '=') {
+        return arg.substr(nome.size() + 1);
+    }
+    if (i + 1 >= argc) {
+        throw std::runtime_error("Erro: opção " + nome + " requer um valor");
+    }
+    return argv[++i];
+}
+
+/**
+ * Converte o valor de uma opção para inteiro positivo
+ */
+int inteiroPositivo(const std::string& valor, const std::string& nome) {
+    size_t lidos = 0;
+    int numero = 0;
+    try {
+        numero = std::stoi(valor, &lidos);
+    } catch (const std::exception&) {
+        lidos = 0;
+    }
+    if (lidos != valor.size() || numero <= 0) {
+        throw std::runtime_error("Erro: valor inválido para " + nome + ": " + valor);
+    }
+    return numero;
+}
+
+/**
+ * Converte o valor de uma opção para número real não negativo
+ */
+double realNaoNegativo(const std::string& valor, const std::string& nome) {
+    size_t lidos = 0;
+    double numero = -1.0;
+    try {
+        numero = std::stod(valor, &lidos);
+    } catch (const std::exception&) {
+        lidos = 0;
+    }
+    if (lidos != valor.size() || !(numero >= 0.0) || numero == HUGE_VAL) {
+        throw std::runtime_error("Erro: valor inválido para " + nome + ": " + valor);
+    }
+    return numero;
+}
+
+/**
+ * Exige que o valor de uma opção não seja vazio
+ */
+std::string textoNaoVazio(const std::string& valor, const std::string& nome) {
+    if (valor.empty()) {
+        throw std::runtime_error("Erro: valor vazio para " + nome);
+    }
+    return valor;
+}
+
+/**
+ * Verifica se o argumento é a opção dada, nas formas "--opcao" ou "--opcao=valor"
+ */
+bool ehOpcao(const std::string& arg, const std::string& nome) {
+    return arg == nome || arg.rfind(nome + "=", 0) == 0;
+}
+
+} // namespace
+
+/**
+ * @brief Interpreta os argumentos da linha de comando
+ */
+Opcoes lerOpcoes(int argc, char* argv[]) {
+    Opcoes opcoes;
+    bool intervaloInformado = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (ehOpcao(arg, "--threads")) {
+            opcoes.threads = inteiroPositivo(valorDaOpcao(argc, argv, i, "--threads"), "--threads");
+        } else if (ehOpcao(arg, "--export-snapshot")) {
+            opcoes.exportarSnapshot = textoNaoVazio(valorDaOpcao(argc, argv, i, "--export-snapshot"), "--export-snapshot");
+        } else if (ehOpcao(arg, "--load-snapshot")) {
+            opcoes.carregarSnapshot = textoNaoVazio(valorDaOpcao(argc, argv, i, "--load-snapshot"), "--load-snapshot");
+        } else if (ehOpcao(arg, "--assign")) {
+            std::string modo = valorDaOpcao(argc, argv, i, "--assign");
+            if (modo == "roundrobin") {
+                opcoes.atribuicao = ModoAtribuicao::RoundRobin;
+            } else if (modo == "cluster") {
+                opcoes.atribuicao = ModoAtribuicao::Cluster;
+            } else {
+                throw std::runtime_error("Erro: valor inválido para --assign: " + modo + " (use roundrobin ou cluster)");
+            }
+            opcoes.relatarDistancia = true;
+        } else if (ehOpcao(arg, "--route")) {
+            opcoes.rota.heuristica = heuristicaRotaPorNome(valorDaOpcao(argc, argv, i, "--route"));
+        } else if (ehOpcao(arg, "--reorder")) {
+            std::string curva = valorDaOpcao(argc, argv, i, "--reorder");
+            if (curva != "hilbert") {
+                throw std::runtime_error("Erro: valor inválido para --reorder: " + curva + " (use hilbert)");
+            }
+            opcoes.reordenarBase = true;
+        } else if (ehOpcao(arg, "--collapse-m")) {
+            opcoes.rota.raioParadasM = realNaoNegativo(valorDaOpcao(argc, argv, i, "--collapse-m"), "--collapse-m");
+        } else if (ehOpcao(arg, "--improve-ms")) {
+            opcoes.rota.melhoriaMs = inteiroPositivo(valorDaOpcao(argc, argv, i, "--improve-ms"), "--improve-ms");
+        } else if (ehOpcao(arg, "--exact-max")) {
+            opcoes.rota.exatoAte = inteiroPositivo(valorDaOpcao(argc, argv, i, "--exact-max"), "--exact-max");
+            if (opcoes.rota.exatoAte > MAXIMO_ROTA_EXATA) {
+                throw std::runtime_error("Erro: --exact-max aceita no máximo " + std::to_string(MAXIMO_ROTA_EXATA) +
+                                         " imóveis");
+            }
+        } else if (ehOpcao(arg, "--rebalance-ms")) {
+            opcoes.rebalanceamento.limiteMs = inteiroPositivo(valorDaOpcao(argc, argv, i, "--rebalance-ms"), "--rebalance-ms");
+        } else if (ehOpcao(arg, "--rebalance-rounds")) {
+            opcoes.rebalanceamento.rodadas = inteiroPositivo(valorDaOpcao(argc, argv, i, "--rebalance-rounds"), "--rebalance-rounds");
+        } else if (ehOpcao(arg, "--rebalance-starts")) {
+            opcoes.rebalanceamento.buscas = inteiroPositivo(valorDaOpcao(argc, argv, i, "--rebalance-starts"), "--rebalance-starts");
+        } else if (ehOpcao(arg, "--seed")) {
+            opcoes.rebalanceamento.semente = static_cast<std::uint64_t>(inteiroPositivo(valorDaOpcao(argc, argv, i, "--seed"), "--seed"));
+        } else if (ehOpcao(arg, "--distance")) {
+            opcoes.rota.distancia = tipoDistanciaPorNome(valorDaOpcao(argc, argv, i, "--distance"));
+            opcoes.relatarProvedor = true;
+        } else if (ehOpcao(arg, "--service-time")) {
+            opcoes.rota.tempo = modeloTempoPorNome(valorDaOpcao(argc, argv, i, "--service-time"));
+        } else if (ehOpcao(arg, "--road-network")) {
+            opcoes.arquivoRede = textoNaoVazio(valorDaOpcao(argc, argv, i, "--road-network"), "--road-network");
+        } else if (ehOpcao(arg, "--input")) {
+            opcoes.arquivoEntrada = textoNaoVazio(valorDaOpcao(argc, argv, i, "--input"), "--input");
+        } else if (arg == "--timings") {
+            opcoes.relatarTempos = true;
+        } else if (ehOpcao(arg, "--metrics-file")) {
+            opcoes.arquivoMetricas = textoNaoVazio(valorDaOpcao(argc, argv, i, "--metrics-file"), "--metrics-file");
+            opcoes.relatarMetricas = true;
+        } else if (ehOpcao(arg, "--metrics")) {
+            std::string formato = valorDaOpcao(argc, argv, i, "--metrics");
+            if (formato != "json") {
+                throw std::runtime_error("Erro: valor inválido para --metrics: " + formato + " (use json)");
+            }
+            opcoes.relatarMetricas = true;
+        } else if (arg == "--daemon") {
+            opcoes.servico = true;
+        } else if (ehOpcao(arg, "--socket")) {
+            opcoes.socketServico = textoNaoVazio(valorDaOpcao(argc, argv, i, "--socket"), "--socket");
+            opcoes.servico = true;
+        } else if (ehOpcao(arg, "--format")) {
+            opcoes.formato = formatoSaidaPorNome(valorDaOpcao(argc, argv, i, "--format"));
+        } else if (ehOpcao(arg, "--batch")) {
+            opcoes.manifestoLote = textoNaoVazio(valorDaOpcao(argc, argv, i, "--batch"), "--batch");
+        } else if (arg == "--pipeline") {
+            opcoes.esteira = true;
+        } else if (ehOpcao(arg, "--checkpoint-ms")) {
+            opcoes.intervaloCheckpointMs = inteiroPositivo(valorDaOpcao(argc, argv, i, "--checkpoint-ms"), "--checkpoint-ms");
+            intervaloInformado = true;
+        } else if (ehOpcao(arg, "--checkpoint")) {
+            opcoes.arquivoCheckpoint = textoNaoVazio(valorDaOpcao(argc, argv, i, "--checkpoint"), "--checkpoint");
+        } else if (arg == "--resume") {
+            opcoes.retomar = true;
+        } else {
+            throw std::runtime_error("Erro: opção desconhecida: " + arg);
+        }
+    }
+    if (!opcoes.carregarSnapshot.empty() && !opcoes.arquivoEntrada.empty()) {
+        throw std::runtime_error("Erro: use apenas uma origem da base (--input ou --load-snapshot)");
+    }
+    if (!opcoes.arquivoRede.empty()) {
+        if (opcoes.relatarProvedor && opcoes.rota.distancia != TipoDistancia::Rede) {
+            throw std::runtime_error("Erro: --road-network só pode ser usado com --distance=road");
+        }
+        opcoes.rota.distancia = TipoDistancia::Rede;
+        opcoes.relatarProvedor = true;
+    } else if (opcoes.rota.distancia == TipoDistancia::Rede) {
+        throw std::runtime_error("Erro: --distance=road exige --road-network");
+    }
+    if (opcoes.servico && opcoes.rota.distancia == TipoDistancia::Rede) {
+        throw std::runtime_error("Erro: --daemon ainda não suporta a distância pela rede viária");
+    }
+    if (!opcoes.manifestoLote.empty() &&
+        (!opcoes.arquivoEntrada.empty() || !opcoes.carregarSnapshot.empty() ||
+         !opcoes.exportarSnapshot.empty() || opcoes.servico)) {
+        throw std::runtime_error("Erro: --batch não pode ser combinado com --input, --load-snapshot, --export-snapshot ou --daemon");
+    }
+    if (opcoes.rebalanceamento.limiteMs > 0 &&
+        (opcoes.esteira || !opcoes.manifestoLote.empty() || opcoes.rota.distancia == TipoDistancia::Rede)) {
+        throw std::runtime_error("Erro: --rebalance-ms não pode ser combinado com --pipeline, --batch ou a distância pela rede viária");
+    }
+    if (opcoes.reordenarBase &&
+        (opcoes.esteira || !opcoes.manifestoLote.empty() || opcoes.servico || !opcoes.exportarSnapshot.empty())) {
+        throw std::runtime_error("Erro: --reorder não pode ser combinado com --pipeline, --batch, --daemon ou --export-snapshot");
+    }
+    if (opcoes.esteira &&
+        (!opcoes.manifestoLote.empty() || !opcoes.carregarSnapshot.empty() || !opcoes.exportarSnapshot.empty() ||
+         opcoes.servico || opcoes.relatarMetricas)) {
+        throw std::runtime_error("Erro: --pipeline não pode ser combinado com --batch, --load-snapshot, --export-snapshot, --daemon ou --metrics");
+    }
+    if (opcoes.arquivoCheckpoint.empty() && (opcoes.retomar || intervaloInformado)) {
+        throw std::runtime_error("Erro: --resume e --checkpoint-ms exigem --checkpoint ARQ");
+    }
+    if (!opcoes.arquivoCheckpoint.empty() &&
+        (opcoes.esteira || !opcoes.manifestoLote.empty() || opcoes.servico || !opcoes.exportarSnapshot.empty())) {
+        throw std::runtime_error("Erro: --checkpoint não pode ser combinado com --pipeline, --batch, --daemon ou --export-snapshot");
+    }
+    if (opcoes.servico && opcoes.socketServico.empty() &&
+        opcoes.carregarSnapshot.empty() && opcoes.arquivoEntrada.empty()) {
+        throw std::runtime_error("Erro: --daemon lê comandos da entrada padrão; informe a base com --input ou --load-snapshot");
+    }
+    return opcoes;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file opcoes.h
+ * @brief Opções de linha de comando do programa
+ * 
+ * Sem argumentos, o programa se comporta exatamente como especificado no
+ * enunciado: lê a entrada padrão e imprime o agendamento na saída padrão.
+ */
+
+#ifndef OPCOES_H
+#define OPCOES_H
+
+#include <string>
+#include "agendamento.h"
+#include "atribuicao.h"
+#include "rebalanceamento.h"
+#include "saida.h"
+
+/**
+ * @struct Opcoes
+ * @brief Configuração da execução obtida dos argumentos
+ */
+struct Opcoes {
+    int threads = 1;              ///< Número de threads usadas para gerar as rotas (--threads N)
+    std::string exportarSnapshot; ///< Grava a base lida neste snapshot e encerra (--export-snapshot ARQ)
+    std::string carregarSnapshot; ///< Lê a base deste snapshot em vez da entrada padrão (--load-snapshot ARQ)
+    ModoAtribuicao atribuicao = ModoAtribuicao::RoundRobin; ///< Distribuição dos imóveis (--assign=roundrobin|cluster)
+    bool relatarDistancia = false; ///< Informa a distância total percorrida (ligado por --assign)
+    bool relatarProvedor = false;  ///< Informa o uso do provedor de distâncias (ligado por --distance)
+    ConfiguracaoRota rota;         ///< Etapas opcionais da rota (--route H, --collapse-m M, --improve-ms N, --exact-max N, --distance TIPO, --service-time M)
+    ConfiguracaoRebalanceamento rebalanceamento; ///< Otimização entre rotas (--rebalance-ms N, --rebalance-rounds N, --rebalance-starts N, --seed S)
+    std::string arquivoRede;       ///< Malha viária usada pelas rotas (--road-network ARQ, implica --distance=road)
+    bool relatarTempos = false;    ///< Informa o tempo de cada fase em JSON (--timings)
+    bool relatarMetricas = false;  ///< Publica as métricas em JSON (--metrics=json)
+    std::string arquivoMetricas;   ///< Grava as métricas neste arquivo em vez da saída de erro (--metrics-file ARQ)
+    std::string arquivoEntrada;    ///< Lê a base deste arquivo texto em vez da entrada padrão (--input ARQ)
+    bool servico = false;          ///< Após gerar as rotas, atende comandos incrementais (--daemon)
+    std::string socketServico;     ///< Socket Unix do modo serviço (--socket ARQ, implica --daemon)
+    FormatoSaida formato = FormatoSaida::Texto; ///< Formato da listagem (--format=text|csv|jsonl)
+    std::string manifestoLote;     ///< Processa as regiões deste manifesto (--batch ARQ, ver lote.h)
+    bool reordenarBase = false;    ///< Reordena os imóveis pela curva de Hilbert após a leitura (--reorder=hilbert, ver curva.h)
+    bool esteira = false;          ///< Leitura, atribuição, rotas e saída sobrepostas (--pipeline, ver esteira.h)
+    std::string arquivoCheckpoint; ///< Grava o progresso das rotas neste arquivo (--checkpoint ARQ, ver checkpoint.h)
+    int intervaloCheckpointMs = 10000; ///< Intervalo entre gravações do checkpoint (--checkpoint-ms N)
+    bool retomar = false;          ///< Retoma do checkpoint, se ele existir (--resume)
+};
+
+/**
+ * @brief Interpreta os argumentos da linha de comando
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos
+ * @return Opções lidas
+ * @throws std::runtime_error se algum argumento for inválido
+ */
+Opcoes lerOpcoes(int argc, char* argv[]);
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file paradas.cpp
+ * @brief Implementação do agrupamento de imóveis em paradas
+ */
+
+#include "paradas.h"
+#include "geografia.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+constexpr double KM_POR_GRAU = EARTH_R * M_PI / 180.0;
+constexpr double MENOR_CELULA_KM = 1e-6; // Com raio 0, células de 1 mm: só coordenadas iguais se encontram
+
+/// Chave de uma célula da grade (colisões só custam candidatos a mais)
+std::uint64_t chaveCelula(std::int64_t linha, std::int64_t coluna) {
+    return static_cast<std::uint64_t>(linha) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(coluna);
+}
+
+} // namespace
+
+/**
+ * @brief Troca cada parada pelos seus imóveis
+ */
+std::vector<int> ParadasRota::expandir(const std::vector<int>& rotaParadas) const {
+    std::vector<int> rota;
+    rota.reserve(membros.size());
+    for (int s : rotaParadas) {
+        rota.insert(rota.end(), membros.begin() + inicio[s], membros.begin() + inicio[s + 1]);
+    }
+    return rota;
+}
+
+/**
+ * @brief Agrupa os pontos de uma rota em paradas
+ */
+ParadasRota agruparParadas(const BlocoCoordenadas& pontos, double raioM) {
+    int n = static_cast<int>(pontos.tamanho());
+    double raioKm = raioM / 1000.0;
+
+    // Células com pelo menos raioKm nos dois eixos: a longitude usa o
+    // cosseno da maior latitude, onde os graus de longitude são mais curtos
+    double maiorLatitude = 0.0;
+    for (int p = 0; p < n; ++p) {
+        maiorLatitude = std::max(maiorLatitude, std::fabs(pontos.latitude[p]));
+    }
+    double celulaKm = std::max(raioKm, MENOR_CELULA_KM);
+    double celulaLat = celulaKm / KM_POR_GRAU;
+    double celulaLon = celulaLat / std::max(std::cos(maiorLatitude * M_PI / 180.0), 1e-3);
+
+    ParadasRota paradas;
+    std::vector<int> paradaDe(n);
+    std::vector<int> lider;
+    std::vector<int> proximoNaCelula; // Parada seguinte da mesma célula (-1 no fim)
+    std::unordered_map<std::uint64_t, int> primeiraDaCelula; // Parada mais recente de cada célula
+    primeiraDaCelula.reserve(n);
+    for (int p = 0; p < n; ++p) {
+        double lat = pontos.latitude[p];
+        double lon = pontos.longitude[p];
+        auto linha = static_cast<std::int64_t>(std::floor(lat / celulaLat));
+        auto coluna = static_cast<std::int64_t>(std::floor(lon / celulaLon));
+
+        // Líder mais próximo a até raioKm nas 9 células em volta (empate: a parada mais antiga)
+        int escolhida = -1;
+        double menor = raioKm;
+        for (std::int64_t dl = -1; dl <= 1; ++dl) {
+            for (std::int64_t dc = -1; dc <= 1; ++dc) {
+                auto it = primeiraDaCelula.find(chaveCelula(linha + dl, coluna + dc));
+                if (it == primeiraDaCelula.end()) {
+                    continue;
+                }
+                for (int s = it->second; s >= 0; s = proximoNaCelula[s]) {
+                    double distancia = haversine(lat, lon, pontos.latitude[lider[s]], pontos.longitude[lider[s]]);
+                    if (distancia < menor || (distancia == menor && (escolhida < 0 || s < escolhida))) {
+                        menor = distancia;
+                        escolhida = s;
+                    }
+                }
+            }
+        }
+        if (escolhida < 0) {
+            escolhida = static_cast<int>(lider.size());
+            lider.push_back(p);
+            auto [it, inserida] = primeiraDaCelula.try_emplace(chaveCelula(linha, coluna), escolhida);
+            proximoNaCelula.push_back(inserida ? -1 : it->second);
+            it->second = escolhida;
+            paradas.pontos.adicionar(lat, lon);
+        }
+        paradaDe[p] = escolhida;
+    }
+
+    // Ordenação por contagem: cada parada com os seus imóveis em ordem de posição
+    int numParadas = static_cast<int>(lider.size());
+    paradas.inicio.assign(numParadas + 1, 0);
+    for (int p = 0; p < n; ++p) {
+        paradas.inicio[paradaDe[p] + 1]++;
+    }
+    for (int s = 0; s < numParadas; ++s) {
+        paradas.inicio[s + 1] += paradas.inicio[s];
+    }
+    std::vector<int> proxima(paradas.inicio.begin(), paradas.inicio.end() - 1);
+    paradas.membros.resize(n);
+    for (int p = 0; p < n; ++p) {
+        paradas.membros[proxima[paradaDe[p]]++] = p;
+    }
+
+    // Com raio, os imóveis com as mesmas coordenadas ficam juntos na parada
+    // (sem idas e vindas entre os pontos dela); com raio 0 nada muda
+    if (raioKm > 0.0) {
+        for (int s = 0; s < numParadas; ++s) {
+            std::sort(paradas.membros.begin() + paradas.inicio[s], paradas.membros.begin() + paradas.inicio[s + 1],
+                      [&](int a, int b) {
+                          return std::tie(pontos.latitude[a], pontos.longitude[a], a) <
+                                 std::tie(pontos.latitude[b], pontos.longitude[b], b);
+                      });
+        }
+    }
+    return paradas;
+}
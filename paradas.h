@@ -0,0 +1,53 @@
+/**
+ * @file paradas.h
+ * @brief Agrupamento de imóveis próximos numa única parada da rota
+ *
+ * Etapa opcional, ligada por --collapse-m M: numa base com prédios, muitos
+ * apartamentos têm as mesmas coordenadas, e o vizinho mais próximo trata
+ * cada um como um candidato, com distâncias nulas entre eles. Com o
+ * agrupamento, os imóveis de um corretor a até M metros de um mesmo imóvel
+ * "líder" viram uma parada; a rota é calculada sobre as paradas e depois
+ * expandida, com os imóveis de cada parada em visitas consecutivas.
+ *
+ * Os imóveis são examinados na ordem da lista: cada um entra na parada do
+ * líder mais próximo a até M metros ou passa a liderar uma parada nova, com
+ * as suas coordenadas. A busca dos líderes usa uma grade com células de M
+ * metros. Com M = 0, só imóveis com coordenadas idênticas são agrupados.
+ */
+
+#ifndef PARADAS_H
+#define PARADAS_H
+
+#include <vector>
+#include "coordenadas.h"
+
+/**
+ * @struct ParadasRota
+ * @brief Paradas de uma rota e os imóveis de cada uma
+ */
+struct ParadasRota {
+    BlocoCoordenadas pontos;   ///< Coordenadas de cada parada (as do seu líder)
+    std::vector<int> inicio;   ///< Imóveis da parada s: membros[inicio[s]] até membros[inicio[s + 1] - 1]
+    std::vector<int> membros;  ///< Posições dos imóveis, agrupadas por parada (ver agruparParadas)
+
+    int numParadas() const { return static_cast<int>(pontos.tamanho()); }
+
+    /**
+     * @brief Troca cada parada da rota pelos seus imóveis, na ordem de membros
+     * @param rotaParadas Paradas (0 a numParadas() - 1) na ordem de visita
+     * @return Posições dos imóveis na ordem de visita
+     */
+    std::vector<int> expandir(const std::vector<int>& rotaParadas) const;
+};
+
+/**
+ * @brief Agrupa os pontos de uma rota em paradas
+ * @param pontos Coordenadas dos imóveis do corretor
+ * @param raioM Distância máxima (metros) de um imóvel ao líder da sua parada; 0 agrupa só coordenadas iguais
+ * @return Paradas numeradas pela ordem do primeiro imóvel de cada uma; dentro
+ *         de cada parada, os imóveis ficam em ordem de posição (raio 0) ou
+ *         agrupados por coordenadas iguais (raio > 0)
+ */
+ParadasRota agruparParadas(const BlocoCoordenadas& pontos, double raioM);
+
+#endif
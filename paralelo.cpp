@@ -0,0 +1,65 @@
+/**
+ * @file paralelo.cpp
+ * @brief Implementação da execução paralela de tarefas
+ */
+
+#include "paralelo.h"
+#include "metricas.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Executa as tarefas usando até numThreads threads
+ * 
+ * A thread atual também trabalha, então são criadas numThreads - 1 threads
+ * auxiliares. Um contador atômico entrega a próxima tarefa a quem ficar livre.
+ * Os contadores de métricas de cada auxiliar são somados aos da thread atual
+ * no fim, como se todo o trabalho tivesse sido feito nela.
+ */
+void executarEmParalelo(int numTarefas, int numThreads, const std::function<void(int)>& tarefa) {
+    numThreads = std::max(1, std::min(numThreads, numTarefas));
+    if (numThreads == 1) {
+        for (int i = 0; i < numTarefas; ++i) {
+            tarefa(i);
+        }
+        return;
+    }
+
+    std::atomic<int> proxima(0);
+    std::vector<std::exception_ptr> erros(numTarefas);
+    auto trabalhar = [&]() {
+        for (int i = proxima++; i < numTarefas; i = proxima++) {
+            try {
+                tarefa(i);
+            } catch (...) {
+                erros[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<ContadoresMetricas> contadoresAuxiliares(numThreads - 1);
+    threads.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            trabalhar();
+            contadoresAuxiliares[t - 1] = contadoresDaThread;
+        });
+    }
+    trabalhar();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& contadores : contadoresAuxiliares) {
+        contadoresDaThread += contadores;
+    }
+
+    for (const auto& erro : erros) {
+        if (erro) {
+            std::rethrow_exception(erro);
+        }
+    }
+}
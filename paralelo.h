@@ -0,0 +1,29 @@
+/**
+ * @file paralelo.h
+ * @brief Execução paralela de tarefas independentes
+ * 
+ * Usado para gerar as rotas dos corretores ao mesmo tempo. Cada tarefa grava
+ * seu resultado numa posição própria, de modo que a ordem da saída não
+ * depende da ordem em que as threads terminam.
+ */
+
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <functional>
+
+/**
+ * @brief Executa tarefa(0) ... tarefa(numTarefas - 1) usando até numThreads threads
+ * 
+ * As tarefas são distribuídas dinamicamente: cada thread pega a próxima
+ * tarefa livre assim que termina a anterior, equilibrando rotas de tamanhos
+ * diferentes. Com numThreads <= 1 tudo roda na thread atual, em ordem.
+ * Se alguma tarefa lançar exceção, a de menor índice é relançada ao final.
+ * 
+ * @param numTarefas Número de tarefas
+ * @param numThreads Número máximo de threads
+ * @param tarefa Função chamada com o índice de cada tarefa
+ */
+void executarEmParalelo(int numTarefas, int numThreads, const std::function<void(int)>& tarefa);
+
+#endif
@@ -0,0 +1,525 @@
+/**
+ * @file rebalanceamento.cpp
+ * @brief Implementação da otimização entre rotas (recozimento simulado em rodadas)
+ */
+
+#include "rebalanceamento.h"
+#include "coordenadas.h"
+#include "geografia.h"
+#include "indice_espacial.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <tuple>
+
+namespace {
+
+constexpr int VIZINHOS_POR_LOCAL = 8;               // Locais vizinhos candidatos a destino
+constexpr int ITERACOES_MINIMAS_POR_RODADA = 1 << 16;
+constexpr int ITERACOES_ENTRE_CONSULTAS_RELOGIO = 1024;
+constexpr int AMOSTRAS_TEMPERATURA = 1024;           // Movimentos sorteados para a temperatura inicial
+constexpr double RAZAO_TEMPERATURA_FINAL = 1e-3;     // Temperatura final / inicial
+constexpr int PERCENTUAL_REALOCACAO = 70;            // O restante dos movimentos são trocas
+constexpr int TENTATIVAS_POR_MOVIMENTO = 16;         // Sorteios até achar um vizinho de outra rota
+constexpr int UNIDADES_POR_MINUTO = 1000;            // Durações da busca em milésimos de minuto
+
+using Relogio = std::chrono::steady_clock;
+
+/// Inteiro uniforme em [0, limite), sem depender das distribuições de <random>
+int sortear(std::mt19937_64& gerador, int limite) {
+    return static_cast<int>(gerador() % static_cast<std::uint64_t>(limite));
+}
+
+/// Real uniforme em [0, 1)
+double sortearReal(std::mt19937_64& gerador) {
+    return static_cast<double>(gerador() >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Dados fixos da instância, só lidos pelas buscas. Os nós 0 a n - 1 são os
+ * imóveis (posição na base) e n + r é a localização do avaliador da rota r.
+ *
+ * Os destinos candidatos vêm dos locais (coordenadas distintas), não dos
+ * imóveis: numa base com prédios, os vizinhos mais próximos de um imóvel
+ * seriam só as outras unidades do mesmo prédio, quase sempre na mesma rota.
+ */
+struct Instancia {
+    int numImoveis = 0;
+    int numRotas = 0;
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<int> servico;          ///< Duração da visita a cada imóvel (UNIDADES_POR_MINUTO)
+    std::vector<int> localDe;          ///< Local de cada imóvel
+    std::vector<int> inicioLocal;      ///< Imóveis do local l: imoveisPorLocal[inicioLocal[l]] ...
+    std::vector<int> imoveisPorLocal;
+    std::vector<int> vizinhosLocal;    ///< VIZINHOS_POR_LOCAL por local (-1 se faltarem)
+
+    /// Um imóvel sorteado no próprio local de v ou num local vizinho
+    int sortearCandidato(int v, std::mt19937_64& gerador) const;
+
+    /**
+     * Deslocamento de a até b (0 se b for o fim da rota), sem o truncamento
+     * da agenda: truncado, todo trecho de menos de meio km sairia de graça e
+     * a busca espalharia os imóveis sem ver a distância crescer
+     */
+    int deslocamento(int a, int b) const {
+        if (b < 0) {
+            return 0;
+        }
+        double km = haversine(latitude[a], longitude[a], latitude[b], longitude[b]);
+        return static_cast<int>(std::lround(km * TEMPO_DESLOCAMENTO_POR_KM * UNIDADES_POR_MINUTO));
+    }
+};
+
+/**
+ * Uma solução: as rotas como listas duplamente encadeadas, os imóveis de
+ * cada rota (para sortear um deles) e as durações, com uma árvore de
+ * máximos para achar a rota que termina mais tarde
+ */
+struct Estado {
+    std::vector<int> proximo;              ///< Próximo nó da rota (-1 no fim)
+    std::vector<int> anterior;             ///< Nó anterior (-1 no início)
+    std::vector<int> rotaDe;               ///< Rota de cada imóvel
+    std::vector<int> posicaoMembro;        ///< Posição de cada imóvel em membros[rotaDe]
+    std::vector<std::vector<int>> membros; ///< Imóveis de cada rota, sem ordem
+    std::vector<long long> arvore;         ///< Máximos das durações; folhas em [folhas, 2 · folhas)
+    int folhas = 1;
+    long long total = 0;                   ///< Soma das durações
+
+    long long duracao(int r) const { return arvore[folhas + r]; }
+    long long maior() const { return arvore[1]; }
+
+    /// Rota de maior duração (a de menor índice nos empates)
+    int rotaMaior() const {
+        int no = 1;
+        while (no < folhas) {
+            no = arvore[2 * no] == arvore[no] ? 2 * no : 2 * no + 1;
+        }
+        return no - folhas;
+    }
+
+    void mudarDuracao(int r, long long valor) {
+        total += valor - duracao(r);
+        int no = folhas + r;
+        arvore[no] = valor;
+        for (no /= 2; no >= 1; no /= 2) {
+            arvore[no] = std::max(arvore[2 * no], arvore[2 * no + 1]);
+        }
+    }
+
+    /// Maior duração entre as rotas [de, ate)
+    long long maiorEntre(int de, int ate) const {
+        long long resultado = -1;
+        for (de += folhas, ate += folhas; de < ate; de /= 2, ate /= 2) {
+            if (de & 1) {
+                resultado = std::max(resultado, arvore[de++]);
+            }
+            if (ate & 1) {
+                resultado = std::max(resultado, arvore[--ate]);
+            }
+        }
+        return resultado;
+    }
+
+    /// Maior duração sem contar as rotas a e b (a != b)
+    long long maiorExceto(int a, int b) const {
+        if (a > b) {
+            std::swap(a, b);
+        }
+        return std::max({maiorEntre(0, a), maiorEntre(a + 1, b), maiorEntre(b + 1, numRotas())});
+    }
+
+    int numRotas() const { return static_cast<int>(membros.size()); }
+
+    /// Fim da última visita mais a duração média das rotas
+    double custo() const { return static_cast<double>(maior()) + static_cast<double>(total) / numRotas(); }
+};
+
+/**
+ * Um movimento avaliado e ainda não aplicado
+ */
+struct Movimento {
+    bool troca = false;
+    int imovel = -1;  ///< Imóvel que sai da rota origem
+    int vizinho = -1; ///< Imóvel da rota destino (troca) ou nó depois do qual o imóvel entra
+    int origem = -1;
+    int destino = -1;
+    long long variacaoOrigem = 0;
+    long long variacaoDestino = 0;
+};
+
+/**
+ * Uma busca: sua cópia da solução e o seu gerador
+ */
+struct Busca {
+    Estado estado;
+    std::mt19937_64 gerador;
+};
+
+int Instancia::sortearCandidato(int v, std::mt19937_64& gerador) const {
+    int local = localDe[v];
+    if (gerador() & 1) {
+        local = vizinhosLocal[static_cast<std::size_t>(local) * VIZINHOS_POR_LOCAL + sortear(gerador, VIZINHOS_POR_LOCAL)];
+        if (local < 0) {
+            return -1;
+        }
+    }
+    int quantidade = inicioLocal[local + 1] - inicioLocal[local];
+    return imoveisPorLocal[inicioLocal[local] + sortear(gerador, quantidade)];
+}
+
+/**
+ * Sorteia e avalia um movimento entre rotas; false se o sorteio não deu um
+ * movimento possível (vizinho na mesma rota, por exemplo)
+ */
+bool sortearMovimento(const Instancia& instancia, const Estado& estado, std::mt19937_64& gerador,
+                      Movimento& movimento) {
+    // Metade das vezes, um imóvel da rota que termina mais tarde. Com a
+    // distribuição por cluster, a maioria dos candidatos está na mesma rota,
+    // então há algumas tentativas de achar um imóvel da borda.
+    int v = -1;
+    int u = -1;
+    bool daMaior = gerador() & 1;
+    const std::vector<int>& membros = estado.membros[estado.rotaMaior()];
+    for (int tentativa = 0; tentativa < TENTATIVAS_POR_MOVIMENTO; ++tentativa) {
+        if (daMaior && !membros.empty()) {
+            v = membros[sortear(gerador, static_cast<int>(membros.size()))];
+        } else {
+            v = sortear(gerador, instancia.numImoveis);
+        }
+        u = instancia.sortearCandidato(v, gerador);
+        if (u >= 0 && estado.rotaDe[u] != estado.rotaDe[v]) {
+            break;
+        }
+        u = -1;
+    }
+    if (u < 0) {
+        return false;
+    }
+    movimento.imovel = v;
+    movimento.origem = estado.rotaDe[v];
+    movimento.destino = estado.rotaDe[u];
+    movimento.troca = sortear(gerador, 100) >= PERCENTUAL_REALOCACAO;
+
+    int pv = estado.anterior[v];
+    int qv = estado.proximo[v];
+    int sv = instancia.servico[v];
+    if (!movimento.troca) {
+        // v sai da origem e entra logo depois ou logo antes de u
+        movimento.variacaoOrigem = -instancia.deslocamento(pv, v) - instancia.deslocamento(v, qv) +
+                                   instancia.deslocamento(pv, qv) - sv;
+        int depois = estado.proximo[u];
+        long long custoDepois = instancia.deslocamento(u, v) + instancia.deslocamento(v, depois) -
+                                instancia.deslocamento(u, depois);
+        int antes = estado.anterior[u];
+        long long custoAntes = instancia.deslocamento(antes, v) + instancia.deslocamento(v, u) -
+                               instancia.deslocamento(antes, u);
+        if (custoDepois <= custoAntes) {
+            movimento.vizinho = u;
+            movimento.variacaoDestino = custoDepois + sv;
+        } else {
+            movimento.vizinho = antes;
+            movimento.variacaoDestino = custoAntes + sv;
+        }
+        return true;
+    }
+
+    // v e u trocam de lugar (estão em rotas diferentes, então não são adjacentes)
+    int pu = estado.anterior[u];
+    int qu = estado.proximo[u];
+    int su = instancia.servico[u];
+    movimento.vizinho = u;
+    movimento.variacaoOrigem = instancia.deslocamento(pv, u) + instancia.deslocamento(u, qv) -
+                               instancia.deslocamento(pv, v) - instancia.deslocamento(v, qv) + su - sv;
+    movimento.variacaoDestino = instancia.deslocamento(pu, v) + instancia.deslocamento(v, qu) -
+                                instancia.deslocamento(pu, u) - instancia.deslocamento(u, qu) + sv - su;
+    return true;
+}
+
+/**
+ * Variação do custo (Estado::custo) se o movimento for aplicado
+ */
+double variacaoCusto(const Estado& estado, const Movimento& movimento) {
+    long long novaOrigem = estado.duracao(movimento.origem) + movimento.variacaoOrigem;
+    long long novoDestino = estado.duracao(movimento.destino) + movimento.variacaoDestino;
+    long long novoMaior = std::max({novaOrigem, novoDestino, estado.maiorExceto(movimento.origem, movimento.destino)});
+    return static_cast<double>(novoMaior - estado.maior()) +
+           static_cast<double>(movimento.variacaoOrigem + movimento.variacaoDestino) / estado.numRotas();
+}
+
+void aplicarMovimento(Estado& estado, const Movimento& movimento) {
+    int v = movimento.imovel;
+    int pv = estado.anterior[v];
+    int qv = estado.proximo[v];
+    if (!movimento.troca) {
+        // Retira v da origem
+        estado.proximo[pv] = qv;
+        if (qv >= 0) {
+            estado.anterior[qv] = pv;
+        }
+        std::vector<int>& origem = estado.membros[movimento.origem];
+        int ultimo = origem.back();
+        origem[estado.posicaoMembro[v]] = ultimo;
+        estado.posicaoMembro[ultimo] = estado.posicaoMembro[v];
+        origem.pop_back();
+
+        // Insere v depois de a
+        int a = movimento.vizinho;
+        int b = estado.proximo[a];
+        estado.proximo[a] = v;
+        estado.anterior[v] = a;
+        estado.proximo[v] = b;
+        if (b >= 0) {
+            estado.anterior[b] = v;
+        }
+        std::vector<int>& destino = estado.membros[movimento.destino];
+        estado.posicaoMembro[v] = static_cast<int>(destino.size());
+        destino.push_back(v);
+    } else {
+        int u = movimento.vizinho;
+        int pu = estado.anterior[u];
+        int qu = estado.proximo[u];
+        estado.proximo[pv] = u;
+        estado.anterior[u] = pv;
+        estado.proximo[u] = qv;
+        if (qv >= 0) {
+            estado.anterior[qv] = u;
+        }
+        estado.proximo[pu] = v;
+        estado.anterior[v] = pu;
+        estado.proximo[v] = qu;
+        if (qu >= 0) {
+            estado.anterior[qu] = v;
+        }
+        estado.membros[movimento.origem][estado.posicaoMembro[v]] = u;
+        estado.membros[movimento.destino][estado.posicaoMembro[u]] = v;
+        std::swap(estado.posicaoMembro[u], estado.posicaoMembro[v]);
+    }
+    estado.rotaDe[v] = movimento.destino;
+    if (movimento.troca) {
+        estado.rotaDe[movimento.vizinho] = movimento.origem;
+    }
+    estado.mudarDuracao(movimento.origem, estado.duracao(movimento.origem) + movimento.variacaoOrigem);
+    estado.mudarDuracao(movimento.destino, estado.duracao(movimento.destino) + movimento.variacaoDestino);
+}
+
+/**
+ * Monta a solução inicial a partir das rotas recebidas
+ */
+Estado montarEstado(const Instancia& instancia, const std::vector<std::vector<int>>& rotas) {
+    int n = instancia.numImoveis;
+    int k = instancia.numRotas;
+    Estado estado;
+    estado.proximo.assign(n + k, -1);
+    estado.anterior.assign(n + k, -1);
+    estado.rotaDe.assign(n, -1);
+    estado.posicaoMembro.assign(n, -1);
+    estado.membros.resize(k);
+    while (estado.folhas < k) {
+        estado.folhas *= 2;
+    }
+    estado.arvore.assign(2 * estado.folhas, -1);
+    for (int r = 0; r < k; ++r) {
+        int atual = n + r;
+        long long duracao = 0;
+        for (int imovelId : rotas[r]) {
+            int v = imovelId - 1;
+            estado.proximo[atual] = v;
+            estado.anterior[v] = atual;
+            estado.rotaDe[v] = r;
+            estado.posicaoMembro[v] = static_cast<int>(estado.membros[r].size());
+            estado.membros[r].push_back(v);
+            duracao += instancia.deslocamento(atual, v) + instancia.servico[v];
+            atual = v;
+        }
+        estado.arvore[estado.folhas + r] = duracao;
+        estado.total += duracao;
+    }
+    for (int no = estado.folhas - 1; no >= 1; --no) {
+        estado.arvore[no] = std::max(estado.arvore[2 * no], estado.arvore[2 * no + 1]);
+    }
+    return estado;
+}
+
+/**
+ * Temperatura inicial: variação média dos movimentos de piora num sorteio
+ * a partir da solução inicial
+ */
+double temperaturaInicial(const Instancia& instancia, const Estado& estado, std::uint64_t semente) {
+    std::mt19937_64 gerador(semente);
+    Movimento movimento;
+    double soma = 0.0;
+    int pioras = 0;
+    for (int i = 0; i < AMOSTRAS_TEMPERATURA; ++i) {
+        if (sortearMovimento(instancia, estado, gerador, movimento)) {
+            double variacao = variacaoCusto(estado, movimento);
+            if (variacao > 0) {
+                soma += variacao;
+                ++pioras;
+            }
+        }
+    }
+    return pioras > 0 ? soma / pioras : 1.0;
+}
+
+} // namespace
+
+/**
+ * @brief Move imóveis entre as rotas para antecipar o fim da última visita
+ */
+ResultadoRebalanceamento rebalancearRotas(const std::vector<Imovel>& imoveis,
+                                          const std::vector<const Corretor*>& avaliadores,
+                                          const std::vector<std::vector<int>>& rotas,
+                                          ModeloTempo tempo,
+                                          const ConfiguracaoRebalanceamento& configuracao,
+                                          int threads) {
+    Relogio::time_point comeco = Relogio::now();
+    Relogio::time_point prazo = comeco + std::chrono::milliseconds(configuracao.limiteMs);
+    ResultadoRebalanceamento resultado;
+
+    // Nós e durações
+    Instancia instancia;
+    int n = static_cast<int>(imoveis.size());
+    int k = static_cast<int>(avaliadores.size());
+    instancia.numImoveis = n;
+    instancia.numRotas = k;
+    instancia.latitude.resize(n + k);
+    instancia.longitude.resize(n + k);
+    instancia.servico.resize(n);
+    for (int i = 0; i < n; ++i) {
+        instancia.latitude[i] = imoveis[i].latitude;
+        instancia.longitude[i] = imoveis[i].longitude;
+        instancia.servico[i] = duracaoAvaliacao(tempo, imoveis[i].tipo) * UNIDADES_POR_MINUTO;
+    }
+    for (int r = 0; r < k; ++r) {
+        instancia.latitude[n + r] = avaliadores[r]->latitude;
+        instancia.longitude[n + r] = avaliadores[r]->longitude;
+    }
+
+    // Locais: imóveis agrupados por coordenadas iguais
+    std::vector<int>& porLocal = instancia.imoveisPorLocal;
+    porLocal.resize(n);
+    std::iota(porLocal.begin(), porLocal.end(), 0);
+    std::sort(porLocal.begin(), porLocal.end(), [&](int a, int b) {
+        return std::tie(instancia.latitude[a], instancia.longitude[a], a) <
+               std::tie(instancia.latitude[b], instancia.longitude[b], b);
+    });
+    instancia.localDe.resize(n);
+    BlocoCoordenadas locais;
+    for (int p = 0; p < n; ++p) {
+        int i = porLocal[p];
+        if (p == 0 || instancia.latitude[i] != instancia.latitude[porLocal[p - 1]] ||
+            instancia.longitude[i] != instancia.longitude[porLocal[p - 1]]) {
+            instancia.inicioLocal.push_back(p);
+            locais.adicionar(instancia.latitude[i], instancia.longitude[i]);
+        }
+        instancia.localDe[i] = static_cast<int>(instancia.inicioLocal.size()) - 1;
+    }
+    int numLocais = static_cast<int>(instancia.inicioLocal.size());
+    instancia.inicioLocal.push_back(n);
+
+    // Locais mais próximos de cada local (em paralelo)
+    instancia.vizinhosLocal.assign(static_cast<std::size_t>(numLocais) * VIZINHOS_POR_LOCAL, -1);
+    if (k >= 2 && numLocais >= 2) {
+        IndiceEspacial indice(locais);
+        int blocos = std::max(1, threads) * 4;
+        executarEmParalelo(blocos, threads, [&](int b) {
+            std::vector<int> posicoes;
+            std::vector<double> distancias;
+            int inicio = static_cast<int>(static_cast<long long>(numLocais) * b / blocos);
+            int fim = static_cast<int>(static_cast<long long>(numLocais) * (b + 1) / blocos);
+            for (int l = inicio; l < fim; ++l) {
+                indice.kMaisProximos(locais.latitude[l], locais.longitude[l], VIZINHOS_POR_LOCAL + 1, posicoes,
+                                     distancias);
+                int* destino = &instancia.vizinhosLocal[static_cast<std::size_t>(l) * VIZINHOS_POR_LOCAL];
+                int usados = 0;
+                for (int p : posicoes) {
+                    if (p != l && usados < VIZINHOS_POR_LOCAL) {
+                        destino[usados++] = p;
+                    }
+                }
+            }
+        });
+    }
+
+    Estado melhor = montarEstado(instancia, rotas);
+    int numBuscas = configuracao.buscas > 0 ? configuracao.buscas : std::max(1, threads);
+    if (k >= 2 && n >= 2) {
+        double inicial = temperaturaInicial(instancia, melhor, configuracao.semente);
+        long long porRodada = std::max(ITERACOES_MINIMAS_POR_RODADA, n / 4);
+        long long totalIteracoes = porRodada * configuracao.rodadas;
+        std::vector<Busca> buscas(numBuscas);
+        std::vector<char> interrompidas(numBuscas, 0);
+
+        for (int rodada = 0; rodada < configuracao.rodadas && !resultado.interrompida; ++rodada) {
+            if (Relogio::now() >= prazo) {
+                resultado.interrompida = true;
+                break;
+            }
+            executarEmParalelo(numBuscas, threads, [&](int b) {
+                Busca& busca = buscas[b];
+                busca.estado = melhor;
+                // Semente própria de cada (busca, rodada): o resultado não depende da ordem das threads
+                std::seed_seq sementes{static_cast<std::uint32_t>(configuracao.semente),
+                                       static_cast<std::uint32_t>(configuracao.semente >> 32),
+                                       static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(rodada)};
+                busca.gerador.seed(sementes);
+                Movimento movimento;
+                double temperatura = inicial;
+                for (long long i = 0; i < porRodada; ++i) {
+                    if (i % ITERACOES_ENTRE_CONSULTAS_RELOGIO == 0) {
+                        Relogio::time_point agora = Relogio::now();
+                        if (agora >= prazo) {
+                            interrompidas[b] = 1;
+                            break;
+                        }
+                        // Esfria só pelas iterações: o relógio apenas interrompe, para que
+                        // a busca completa não dependa da velocidade nem de --threads
+                        double progresso = static_cast<double>(rodada * porRodada + i) / totalIteracoes;
+                        temperatura = inicial * std::pow(RAZAO_TEMPERATURA_FINAL, progresso);
+                    }
+                    if (!sortearMovimento(instancia, busca.estado, busca.gerador, movimento)) {
+                        continue;
+                    }
+                    double variacao = variacaoCusto(busca.estado, movimento);
+                    if (variacao <= 0 || sortearReal(busca.gerador) < std::exp(-variacao / temperatura)) {
+                        aplicarMovimento(busca.estado, movimento);
+                    }
+                }
+            });
+
+            // A melhor busca da rodada (menor índice nos empates) substitui a compartilhada se for melhor
+            int vencedora = -1;
+            double melhorCusto = melhor.custo();
+            for (int b = 0; b < numBuscas; ++b) {
+                if (buscas[b].estado.custo() < melhorCusto) {
+                    melhorCusto = buscas[b].estado.custo();
+                    vencedora = b;
+                }
+                resultado.interrompida = resultado.interrompida || interrompidas[b];
+            }
+            if (vencedora >= 0) {
+                melhor = std::move(buscas[vencedora].estado);
+            }
+            if (!resultado.interrompida) {
+                resultado.rodadas = rodada + 1;
+            }
+        }
+    }
+
+    // Imóveis de cada avaliador na ordem de visita
+    Atribuicao& atribuicao = resultado.atribuicao;
+    atribuicao.avaliadores = avaliadores;
+    atribuicao.inicio.assign(k + 1, 0);
+    atribuicao.imoveis.reserve(n);
+    for (int r = 0; r < k; ++r) {
+        for (int v = melhor.proximo[n + r]; v >= 0; v = melhor.proximo[v]) {
+            atribuicao.imoveis.push_back(v + 1);
+        }
+        atribuicao.inicio[r + 1] = static_cast<std::uint32_t>(atribuicao.imoveis.size());
+    }
+    return resultado;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file rebalanceamento.h
+ * @brief Otimização entre rotas: imóveis trocam de avaliador (--rebalance-ms)
+ *
+ * A distribuição (Round-Robin ou cluster) e a geração das rotas nunca
+ * movem um imóvel de um avaliador para outro, então o fim da última visita
+ * do dia costuma ser definido por uma rota mal carregada. Esta etapa parte
+ * das rotas já geradas e aplica recozimento simulado com dois movimentos
+ * entre rotas diferentes:
+ *   - realocação: um imóvel sai da sua rota e entra ao lado de um dos seus
+ *     vizinhos mais próximos, na rota desse vizinho;
+ *   - troca: um imóvel e um vizinho de outra rota trocam de lugar.
+ * O custo é o fim da última visita mais a duração média das rotas (em
+ * minutos, com o mesmo modelo de tempo da agenda), então o primeiro
+ * critério é o horário de término e o segundo, o trabalho total.
+ *
+ * Várias buscas (uma por semente derivada de --seed) rodam em paralelo
+ * em rodadas: todas começam cada rodada da melhor solução até então e, no
+ * fim da rodada, a melhor delas (empates ficam com a de menor índice)
+ * passa a ser a compartilhada. Cada busca usa só o seu gerador, então o
+ * resultado depende apenas da semente, do número de buscas e do número de
+ * rodadas, nunca de --threads. A temperatura cai só com as iterações; o
+ * limite de tempo é verificado durante as rodadas apenas para parar. Se ele
+ * interromper a busca antes da última rodada, o resultado continua válido,
+ * mas deixa de ser reprodutível.
+ */
+
+#ifndef REBALANCEAMENTO_H
+#define REBALANCEAMENTO_H
+
+#include <cstdint>
+#include <vector>
+#include "agendamento.h"
+#include "atribuicao.h"
+#include "imovel.h"
+
+/**
+ * @struct ConfiguracaoRebalanceamento
+ * @brief Parâmetros da otimização entre rotas
+ */
+struct ConfiguracaoRebalanceamento {
+    int limiteMs = 0;          ///< Tempo de parede da busca (--rebalance-ms); 0 desliga
+    int rodadas = 100;         ///< Rodadas com troca da melhor solução (--rebalance-rounds)
+    int buscas = 0;            ///< Buscas em paralelo (--rebalance-starts); 0 usa uma por thread
+    std::uint64_t semente = 1; ///< Semente das buscas (--seed)
+};
+
+/**
+ * @struct ResultadoRebalanceamento
+ * @brief Nova distribuição e o que a busca conseguiu fazer
+ */
+struct ResultadoRebalanceamento {
+    Atribuicao atribuicao;      ///< Imóveis de cada avaliador, na ordem de visita
+    int rodadas = 0;            ///< Rodadas concluídas
+    bool interrompida = false;  ///< O limite de tempo terminou a busca antes da última rodada
+};
+
+/**
+ * @brief Move imóveis entre as rotas para antecipar o fim da última visita
+ *
+ * As distâncias são as do haversine (as mesmas do provedor padrão e do de
+ * cache), com o deslocamento truncado em minutos por trecho, como na agenda.
+ *
+ * @param imoveis Base completa (o ID é a posição + 1)
+ * @param avaliadores Avaliadores, em ordem de ID
+ * @param rotas IDs dos imóveis de cada avaliador, na ordem de visita
+ * @param tempo Modelo da duração das visitas
+ * @param configuracao Limite de tempo, rodadas, buscas e semente
+ * @param threads Threads usadas pelas buscas de cada rodada
+ * @return Imóveis de cada avaliador na ordem de visita encontrada; as rotas
+ *         devem ser agendadas nessa ordem (ConfiguracaoRota::manterOrdem)
+ */
+ResultadoRebalanceamento rebalancearRotas(const std::vector<Imovel>& imoveis,
+                                          const std::vector<const Corretor*>& avaliadores,
+                                          const std::vector<std::vector<int>>& rotas,
+                                          ModeloTempo tempo,
+                                          const ConfiguracaoRebalanceamento& configuracao,
+                                          int threads);
+
+#endif
@@ -0,0 +1,533 @@
+/**
+ * @file rede_viaria.cpp
+ * @brief Implementação da rede viária (carga, contração e consultas)
+ */
+
+#include "rede_viaria.h"
+#include "coordenadas.h"
+#include "geografia.h"
+#include "leitor.h"
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+constexpr double INFINITO = std::numeric_limits<double>::infinity();
+
+// Máximo de nós fechados por busca de testemunha; acima disso o atalho é
+// criado mesmo que talvez não fosse necessário (só custa memória). Para
+// estimar a prioridade basta uma busca mais curta.
+constexpr int LIMITE_TESTEMUNHA = 500;
+constexpr int LIMITE_TESTEMUNHA_ESTIMATIVA = 20;
+
+using Adjacencia = std::vector<std::vector<std::pair<int, double>>>;
+
+struct ArestaLida {
+    long long origem;
+    long long destino;
+    double km;
+    bool temKm;
+};
+
+void invalida(const std::string& motivo) {
+    throw std::runtime_error("Erro: rede viária inválida: " + motivo);
+}
+
+bool lerId(LeitorEntrada& campos, long long& id) {
+    std::string_view palavra;
+    if (!campos.lerPalavra(palavra)) {
+        return false;
+    }
+    auto [fim, erro] = std::from_chars(palavra.data(), palavra.data() + palavra.size(), id);
+    return erro == std::errc() && fim == palavra.data() + palavra.size();
+}
+
+/**
+ * Liga u e w com custo c, ou reduz o custo da ligação existente
+ * @return true se uma ligação nova foi criada
+ */
+bool ligar(Adjacencia& adjacencia, int u, int w, double c) {
+    for (auto& [vizinho, custo] : adjacencia[u]) {
+        if (vizinho == w) {
+            if (c < custo) {
+                custo = c;
+                for (auto& [outro, custoOutro] : adjacencia[w]) {
+                    if (outro == u) {
+                        custoOutro = c;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+    adjacencia[u].emplace_back(w, c);
+    adjacencia[w].emplace_back(u, c);
+    return true;
+}
+
+/**
+ * Dijkstra limitado que procura caminhos alternativos ("testemunhas") entre
+ * os vizinhos de um nó sem passar por ele
+ */
+class BuscaTestemunha {
+public:
+    explicit BuscaTestemunha(int n) : distancia(n, INFINITO), alvo(n, 0) {}
+
+    /**
+     * Distâncias a partir de origem sem passar por ignorado; para ao fechar
+     * todos os alvos, ao passar de limite ou de maxFechados nós
+     */
+    void executar(int origem, int ignorado, double limite, int maxFechados, const std::vector<int>& alvos,
+                  const Adjacencia& adjacencia) {
+        for (int w : alvos) {
+            alvo[w] = 1;
+        }
+        int restantes = static_cast<int>(alvos.size());
+        for (int v : tocados) {
+            distancia[v] = INFINITO;
+        }
+        tocados.clear();
+        fila.clear();
+        distancia[origem] = 0.0;
+        tocados.push_back(origem);
+        fila.emplace_back(0.0, origem);
+        int fechados = 0;
+        while (!fila.empty()) {
+            auto [d, v] = fila.front();
+            std::pop_heap(fila.begin(), fila.end(), std::greater<>());
+            fila.pop_back();
+            if (d > distancia[v]) {
+                continue;
+            }
+            if (d > limite || ++fechados > maxFechados) {
+                break;
+            }
+            if (alvo[v] && --restantes == 0) {
+                break;
+            }
+            for (const auto& [w, c] : adjacencia[v]) {
+                double nova = d + c;
+                if (w != ignorado && nova < distancia[w]) {
+                    if (distancia[w] == INFINITO) {
+                        tocados.push_back(w);
+                    }
+                    distancia[w] = nova;
+                    fila.emplace_back(nova, w);
+                    std::push_heap(fila.begin(), fila.end(), std::greater<>());
+                }
+            }
+        }
+        for (int w : alvos) {
+            alvo[w] = 0;
+        }
+    }
+
+    double operator[](int v) const { return distancia[v]; }
+
+private:
+    std::vector<double> distancia;
+    std::vector<int> tocados;
+    std::vector<std::pair<double, int>> fila;
+    std::vector<char> alvo;
+};
+
+/**
+ * Atalhos necessários para contrair v: um para cada par de vizinhos cujo
+ * caminho mais curto passa por v. Se novos não for nulo, recebe os atalhos;
+ * senão é só uma estimativa (busca mais curta, pode sobrar atalho).
+ */
+int atalhosNecessarios(int v, const Adjacencia& adjacencia, BuscaTestemunha& busca,
+                       std::vector<std::tuple<int, int, double>>* novos) {
+    const auto& vizinhos = adjacencia[v];
+    int total = 0;
+    std::vector<int> alvos;
+    for (std::size_t i = 0; i + 1 < vizinhos.size(); ++i) {
+        auto [u, custoU] = vizinhos[i];
+        double limite = 0.0;
+        alvos.clear();
+        for (std::size_t j = i + 1; j < vizinhos.size(); ++j) {
+            limite = std::max(limite, custoU + vizinhos[j].second);
+            alvos.push_back(vizinhos[j].first);
+        }
+        busca.executar(u, v, limite, novos ? LIMITE_TESTEMUNHA : LIMITE_TESTEMUNHA_ESTIMATIVA, alvos, adjacencia);
+        for (std::size_t j = i + 1; j < vizinhos.size(); ++j) {
+            auto [w, custoW] = vizinhos[j];
+            double via = custoU + custoW;
+            if (busca[w] > via) {
+                ++total;
+                if (novos) {
+                    novos->emplace_back(u, w, via);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+/**
+ * @brief Lê a rede do arquivo e faz o pré-processamento
+ *
+ * Linhas vazias e iniciadas por '#' são ignoradas; as arestas podem vir
+ * antes dos nós que usam.
+ */
+RedeViaria::RedeViaria(const std::string& caminho) {
+    LeitorEntrada entrada(caminho);
+    std::unordered_map<long long, int> noDoId;
+    std::vector<ArestaLida> lidas;
+    for (int registro = 1;; ++registro) {
+        std::string_view linha = entrada.lerRestoDaLinha();
+        if (linha.empty()) {
+            break;
+        }
+        LeitorEntrada campos(linha.data(), linha.size());
+        std::string_view tipo;
+        campos.lerPalavra(tipo);
+        if (tipo[0] == '#') {
+            continue;
+        }
+        std::string onde = "registro " + std::to_string(registro);
+        if (tipo == "v") {
+            long long id;
+            double lat, lon;
+            if (!(lerId(campos, id) && campos.lerReal(lat) && campos.lerReal(lon))) {
+                invalida(onde + ": use \"v ID LATITUDE LONGITUDE\"");
+            }
+            if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
+                invalida(onde + ": coordenadas fora do intervalo");
+            }
+            if (!noDoId.emplace(id, numNos()).second) {
+                invalida(onde + ": nó " + std::to_string(id) + " repetido");
+            }
+            latitude.push_back(lat);
+            longitude.push_back(lon);
+        } else if (tipo == "e") {
+            ArestaLida aresta{};
+            if (!(lerId(campos, aresta.origem) && lerId(campos, aresta.destino))) {
+                invalida(onde + ": use \"e ID1 ID2 [KM]\"");
+            }
+            std::string_view custo;
+            aresta.temKm = campos.lerPalavra(custo);
+            if (aresta.temKm) {
+                auto [fim, erro] = std::from_chars(custo.data(), custo.data() + custo.size(), aresta.km);
+                if (erro != std::errc() || fim != custo.data() + custo.size() || !(aresta.km >= 0.0)) {
+                    invalida(onde + ": custo inválido \"" + std::string(custo) + "\"");
+                }
+            }
+            lidas.push_back(aresta);
+        } else {
+            invalida(onde + ": tipo desconhecido \"" + std::string(tipo) + "\"");
+        }
+    }
+    if (latitude.empty()) {
+        invalida("nenhum nó");
+    }
+
+    int n = numNos();
+    Adjacencia adjacencia(n);
+    for (const ArestaLida& aresta : lidas) {
+        auto u = noDoId.find(aresta.origem);
+        auto w = noDoId.find(aresta.destino);
+        if (u == noDoId.end() || w == noDoId.end()) {
+            invalida("aresta " + std::to_string(aresta.origem) + "-" + std::to_string(aresta.destino) +
+                     " usa nó inexistente");
+        }
+        if (u->second == w->second) {
+            continue;
+        }
+        double retaKm = haversine(latitude[u->second], longitude[u->second],
+                                  latitude[w->second], longitude[w->second]);
+        if (ligar(adjacencia, u->second, w->second, aresta.temKm ? std::max(aresta.km, retaKm) : retaKm)) {
+            ++arestas;
+        }
+    }
+
+    // Maior componente conexa: só os seus nós recebem pontos
+    std::vector<int> componente(n, -1);
+    int maior = -1;
+    std::size_t tamanhoMaior = 0;
+    std::vector<int> pilha;
+    for (int raiz = 0, rotulo = 0; raiz < n; ++raiz) {
+        if (componente[raiz] >= 0) {
+            continue;
+        }
+        std::size_t tamanho = 0;
+        componente[raiz] = rotulo;
+        pilha.push_back(raiz);
+        while (!pilha.empty()) {
+            int v = pilha.back();
+            pilha.pop_back();
+            ++tamanho;
+            for (const auto& [w, c] : adjacencia[v]) {
+                if (componente[w] < 0) {
+                    componente[w] = rotulo;
+                    pilha.push_back(w);
+                }
+            }
+        }
+        if (tamanho > tamanhoMaior) {
+            tamanhoMaior = tamanho;
+            maior = rotulo;
+        }
+        ++rotulo;
+    }
+    BlocoCoordenadas nosEncaixe;
+    nosEncaixe.reservar(tamanhoMaior);
+    noDoEncaixe.reserve(tamanhoMaior);
+    for (int v = 0; v < n; ++v) {
+        if (componente[v] == maior) {
+            nosEncaixe.adicionar(latitude[v], longitude[v]);
+            noDoEncaixe.push_back(v);
+        }
+    }
+    indiceEncaixe = std::make_unique<IndiceEspacial>(nosEncaixe);
+
+    contrair(adjacencia);
+}
+
+/**
+ * Ordena e contrai os nós, montando o grafo ascendente
+ *
+ * A prioridade de um nó combina a "diferença de arestas" (atalhos criados
+ * menos ligações removidas, com peso 2), o número de vizinhos já contraídos
+ * e o nível (1 + o maior nível entre os vizinhos contraídos antes dele); os
+ * dois últimos termos espalham a contração pelo grafo e mantêm as buscas
+ * rasas. A atualização é preguiçosa: o nó do topo da fila tem a prioridade
+ * recalculada e volta para a fila se deixou de ser o menor.
+ */
+void RedeViaria::contrair(Adjacencia& adjacencia) {
+    int n = numNos();
+    BuscaTestemunha busca(n);
+    std::vector<int> vizinhosContraidos(n, 0);
+    std::vector<int> nivel(n, 0);
+    auto prioridade = [&](int v) {
+        int diferenca = atalhosNecessarios(v, adjacencia, busca, nullptr) - static_cast<int>(adjacencia[v].size());
+        return 2 * diferenca + vizinhosContraidos[v] + nivel[v];
+    };
+
+    using ItemFila = std::pair<int, int>; // (prioridade, nó)
+    std::priority_queue<ItemFila, std::vector<ItemFila>, std::greater<>> fila;
+    for (int v = 0; v < n; ++v) {
+        fila.emplace(prioridade(v), v);
+    }
+
+    Adjacencia subida(n);
+    std::vector<std::tuple<int, int, double>> novos;
+    while (!fila.empty()) {
+        int v = fila.top().second;
+        fila.pop();
+        int atual = prioridade(v);
+        if (!fila.empty() && atual > fila.top().first) {
+            fila.emplace(atual, v);
+            continue;
+        }
+
+        novos.clear();
+        atalhosNecessarios(v, adjacencia, busca, &novos);
+        // As ligações restantes de v levam a nós ainda não contraídos: sobem na hierarquia
+        subida[v] = std::move(adjacencia[v]);
+        adjacencia[v] = {};
+        for (const auto& [w, c] : subida[v]) {
+            auto& lista = adjacencia[w];
+            for (std::size_t i = 0; i < lista.size(); ++i) {
+                if (lista[i].first == v) {
+                    lista[i] = lista.back();
+                    lista.pop_back();
+                    break;
+                }
+            }
+            ++vizinhosContraidos[w];
+            nivel[w] = std::max(nivel[w], nivel[v] + 1);
+        }
+        for (const auto& [u, w, c] : novos) {
+            if (ligar(adjacencia, u, w, c)) {
+                ++atalhos;
+            }
+        }
+    }
+
+    inicioSubida.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v) {
+        inicioSubida[v + 1] = inicioSubida[v] + static_cast<int>(subida[v].size());
+    }
+    destinoSubida.reserve(inicioSubida[n]);
+    pesoSubida.reserve(inicioSubida[n]);
+    for (int v = 0; v < n; ++v) {
+        for (const auto& [w, c] : subida[v]) {
+            destinoSubida.push_back(w);
+            pesoSubida.push_back(c);
+        }
+    }
+}
+
+/**
+ * @brief Liga um ponto ao nó mais próximo da maior componente conexa
+ */
+int RedeViaria::encaixar(double lat, double lon, double& distanciaKm) const {
+    return noDoEncaixe[indiceEncaixe->maisProximo(lat, lon, distanciaKm)];
+}
+
+void RedeViaria::iniciarBusca(Busca& busca) const {
+    std::size_t n = latitude.size();
+    if (busca.distancia[0].size() != n || ++busca.geracao == 0) {
+        for (int lado = 0; lado < 2; ++lado) {
+            busca.distancia[lado].assign(n, INFINITO);
+            busca.marca[lado].assign(n, 0);
+        }
+        busca.geracao = 1;
+    }
+    busca.fila[0].clear();
+    busca.fila[1].clear();
+}
+
+/**
+ * "Stall-on-demand": v chegou com distância d, mas algum nó acima dele já
+ * alcançado tem um caminho mais curto até v. Então d não é a distância real
+ * e v não precisa ser expandido (nem servir de encontro). Como a rede é de
+ * mão dupla, as arestas de subida de v são as mesmas que descem até ele.
+ */
+bool RedeViaria::parado(int v, double d, const std::vector<double>& distancia,
+                        const std::vector<std::uint32_t>& marca, std::uint32_t geracao) const {
+    for (int a = inicioSubida[v]; a < inicioSubida[v + 1]; ++a) {
+        int w = destinoSubida[a];
+        if (marca[w] == geracao && distancia[w] + pesoSubida[a] < d) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Distância pela rede entre dois nós
+ *
+ * Busca bidirecional no grafo ascendente: cada lado só sobe na hierarquia
+ * e o caminho mais curto passa pelo nó mais alto dele, fechado pelos dois
+ * lados. Um lado para quando o seu menor valor pendente já não melhora o
+ * melhor encontro.
+ */
+double RedeViaria::distancia(int origem, int destino, Busca& busca) const {
+    if (origem == destino) {
+        return 0.0;
+    }
+    iniciarBusca(busca);
+    auto valor = [&](int lado, int v) {
+        return busca.marca[lado][v] == busca.geracao ? busca.distancia[lado][v] : INFINITO;
+    };
+    auto definir = [&](int lado, int v, double d) {
+        busca.marca[lado][v] = busca.geracao;
+        busca.distancia[lado][v] = d;
+        busca.fila[lado].emplace_back(d, v);
+        std::push_heap(busca.fila[lado].begin(), busca.fila[lado].end(), std::greater<>());
+    };
+    definir(0, origem, 0.0);
+    definir(1, destino, 0.0);
+
+    double melhor = INFINITO;
+    while (!busca.fila[0].empty() || !busca.fila[1].empty()) {
+        for (int lado = 0; lado < 2; ++lado) {
+            auto& fila = busca.fila[lado];
+            if (fila.empty()) {
+                continue;
+            }
+            auto [d, v] = fila.front();
+            if (d >= melhor) {
+                fila.clear();
+                continue;
+            }
+            std::pop_heap(fila.begin(), fila.end(), std::greater<>());
+            fila.pop_back();
+            if (d > valor(lado, v)) {
+                continue;
+            }
+            melhor = std::min(melhor, d + valor(1 - lado, v));
+            if (parado(v, d, busca.distancia[lado], busca.marca[lado], busca.geracao)) {
+                continue;
+            }
+            for (int a = inicioSubida[v]; a < inicioSubida[v + 1]; ++a) {
+                double nova = d + pesoSubida[a];
+                if (nova < valor(lado, destinoSubida[a])) {
+                    definir(lado, destinoSubida[a], nova);
+                }
+            }
+        }
+    }
+    return melhor;
+}
+
+/**
+ * Busca ascendente completa a partir de um nó; os nós fechados e suas
+ * distâncias ficam em busca.assentados
+ */
+void RedeViaria::subirCompleto(int origem, Busca& busca) const {
+    iniciarBusca(busca);
+    busca.assentados.clear();
+    auto& fila = busca.fila[0];
+    auto& distancia = busca.distancia[0];
+    auto& marca = busca.marca[0];
+    marca[origem] = busca.geracao;
+    distancia[origem] = 0.0;
+    fila.emplace_back(0.0, origem);
+    while (!fila.empty()) {
+        auto [d, v] = fila.front();
+        std::pop_heap(fila.begin(), fila.end(), std::greater<>());
+        fila.pop_back();
+        if (d > distancia[v] || parado(v, d, distancia, marca, busca.geracao)) {
+            continue;
+        }
+        busca.assentados.emplace_back(v, d);
+        for (int a = inicioSubida[v]; a < inicioSubida[v + 1]; ++a) {
+            int w = destinoSubida[a];
+            double nova = d + pesoSubida[a];
+            if (marca[w] != busca.geracao || nova < distancia[w]) {
+                marca[w] = busca.geracao;
+                distancia[w] = nova;
+                fila.emplace_back(nova, w);
+                std::push_heap(fila.begin(), fila.end(), std::greater<>());
+            }
+        }
+    }
+}
+
+/**
+ * @brief Distâncias entre todos os pares de uma lista de nós
+ *
+ * Uma subida completa por nó; cada nó alcançado guarda num "balde" as
+ * distâncias das pontas que chegaram a ele. A distância de i a j é o menor
+ * d(i, v) + d(j, v) entre os nós v alcançados pelos dois. Como a rede é de
+ * mão dupla, basta calcular j > i e espelhar.
+ */
+void RedeViaria::matrizDistancias(const std::vector<int>& nos, Busca& busca, std::vector<double>& matriz) const {
+    std::size_t m = nos.size();
+    matriz.assign(m * m, INFINITO);
+    std::vector<std::vector<std::pair<int, double>>> alcancados(m);
+    std::unordered_map<int, std::vector<std::pair<int, double>>> baldes;
+    for (std::size_t i = 0; i < m; ++i) {
+        subirCompleto(nos[i], busca);
+        alcancados[i] = busca.assentados;
+        for (const auto& [v, d] : busca.assentados) {
+            baldes[v].emplace_back(static_cast<int>(i), d);
+        }
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+        double* linha = &matriz[i * m];
+        linha[i] = 0.0;
+        for (const auto& [v, di] : alcancados[i]) {
+            for (const auto& [j, dj] : baldes[v]) {
+                if (static_cast<std::size_t>(j) > i && di + dj < linha[j]) {
+                    linha[j] = di + dj;
+                }
+            }
+        }
+        for (std::size_t j = i + 1; j < m; ++j) {
+            matriz[j * m + i] = linha[j];
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file rede_viaria.h
+ * @brief Distâncias pela malha viária com hierarquias de contração
+ *
+ * A rede é lida de um arquivo texto com um registro por linha:
+ *
+ *     # comentário
+ *     v ID LATITUDE LONGITUDE     (nó; ID inteiro qualquer, por exemplo do OSM)
+ *     e ID1 ID2 [KM]              (via de mão dupla entre dois nós)
+ *
+ * O custo de uma via é o comprimento em km (ou "km equivalentes", para
+ * representar vias mais lentas: o tempo continua sendo 2 min/km). Sem KM,
+ * vale a distância em linha reta entre os nós; um custo menor que ela é
+ * elevado a ela, para que a distância pela rede nunca fique abaixo de
+ * haversine (o índice espacial usa haversine como limite inferior).
+ *
+ * Na carga, os nós são ordenados e contraídos (hierarquia de contração):
+ * cada nó contraído ganha atalhos entre os vizinhos que dependiam dele, e
+ * o resultado é um grafo "ascendente" em que uma consulta é uma busca de
+ * Dijkstra de cada ponta, só subindo na hierarquia, com poucas centenas de
+ * nós visitados. Para muitos pares (matriz de uma rota), as buscas de todas
+ * as pontas são feitas uma vez só e cruzadas por "baldes" nos nós comuns.
+ *
+ * Pontos fora da rede (imóveis e corretores) são ligados ao nó mais próximo
+ * da maior componente conexa, e o trecho até ele (em linha reta) entra na
+ * distância.
+ */
+
+#ifndef REDE_VIARIA_H
+#define REDE_VIARIA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "indice_espacial.h"
+
+/**
+ * @class RedeViaria
+ * @brief Malha viária pré-processada; consultas constantes e seguras entre threads
+ */
+class RedeViaria {
+public:
+    /**
+     * @brief Lê a rede do arquivo e faz o pré-processamento
+     * @throws std::runtime_error se o arquivo não existir ou for inválido
+     */
+    explicit RedeViaria(const std::string& caminho);
+
+    /**
+     * @class Busca
+     * @brief Memória de trabalho das consultas (uma por thread ou por rota)
+     */
+    class Busca {
+    private:
+        friend class RedeViaria;
+        std::vector<double> distancia[2];        ///< Por lado (subida da origem / do destino)
+        std::vector<std::uint32_t> marca[2];     ///< Busca em que distancia[lado][v] foi escrita
+        std::uint32_t geracao = 0;
+        std::vector<std::pair<double, int>> fila[2];
+        std::vector<std::pair<int, double>> assentados; ///< Nós fechados pela última subida completa
+    };
+
+    /**
+     * @brief Liga um ponto ao nó mais próximo da maior componente conexa
+     * @param distanciaKm Recebe a distância (haversine) do ponto ao nó
+     * @return Nó escolhido
+     */
+    int encaixar(double lat, double lon, double& distanciaKm) const;
+
+    /**
+     * @brief Distância (km) pela rede entre dois nós da mesma componente
+     */
+    double distancia(int origem, int destino, Busca& busca) const;
+
+    /**
+     * @brief Distâncias entre todos os pares de uma lista de nós
+     * @param nos Nós da mesma componente
+     * @param matriz Recebe nos.size() x nos.size() valores, por linha
+     */
+    void matrizDistancias(const std::vector<int>& nos, Busca& busca, std::vector<double>& matriz) const;
+
+    int numNos() const { return static_cast<int>(latitude.size()); }
+    std::size_t numArestas() const { return arestas; }
+    std::size_t numAtalhos() const { return atalhos; }
+    std::size_t numNosComponente() const { return noDoEncaixe.size(); }
+
+private:
+    std::vector<double> latitude, longitude;
+    std::vector<int> noDoEncaixe;                  ///< Nós da maior componente, na ordem do índice
+    std::unique_ptr<IndiceEspacial> indiceEncaixe; ///< Índice sobre os nós de noDoEncaixe
+
+    // Grafo ascendente em CSR: arestas de cada nó para nós contraídos depois dele
+    std::vector<int> inicioSubida;
+    std::vector<int> destinoSubida;
+    std::vector<double> pesoSubida;
+
+    std::size_t arestas = 0;
+    std::size_t atalhos = 0;
+
+    void contrair(std::vector<std::vector<std::pair<int, double>>>& adjacencia);
+    void subirCompleto(int origem, Busca& busca) const;
+    void iniciarBusca(Busca& busca) const;
+    bool parado(int v, double d, const std::vector<double>& distancia,
+                const std::vector<std::uint32_t>& marca, std::uint32_t geracao) const;
+};
+
+#endif
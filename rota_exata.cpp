@@ -0,0 +1,132 @@
+/**
+ * @file rota_exata.cpp
+ * @brief Implementação do Held-Karp em camadas
+ */
+
+#include "rota_exata.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+/// Camadas com menos conjuntos que isso rodam numa thread só
+constexpr std::size_t MINIMO_CAMADA_PARALELA = 1024;
+
+/**
+ * Posição de i entre os elementos do conjunto (quantos elementos menores há)
+ */
+inline int posicaoNoConjunto(std::uint32_t conjunto, int i) {
+    return __builtin_popcount(conjunto & ((1u << i) - 1));
+}
+
+} // namespace
+
+/**
+ * @brief Ordem de visita de menor distância total
+ *
+ * custo[inicio[S] + posição de i em S] é o menor caminho que sai do
+ * corretor, visita todos os imóveis de S e termina em i ∈ S. Os valores de
+ * um mesmo conjunto ficam juntos, então o cálculo de S lê, para cada i, um
+ * bloco contíguo (o de S sem i). Um conjunto com k imóveis depende só de
+ * conjuntos com k - 1, então cada camada é calculada em paralelo depois da
+ * anterior. O caminho é refeito de trás para frente procurando, em cada
+ * passo, o antecessor cuja soma reproduz o valor da tabela; a soma é a
+ * mesma expressão do cálculo, então não é preciso guardar antecessores.
+ */
+std::vector<int> caminhoOtimo(const std::vector<double>& distancias, int n, int threads) {
+    const std::size_t m = static_cast<std::size_t>(n) + 1;
+    const std::size_t numConjuntos = std::size_t(1) << n;
+
+    // chegada[i · n + j] = distância do imóvel j ao imóvel i, contígua em j
+    std::vector<double> chegada(static_cast<std::size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            chegada[static_cast<std::size_t>(i) * n + j] = distancias[(j + 1) * m + i + 1];
+        }
+    }
+
+    // Início de cada conjunto na tabela e conjuntos agrupados por tamanho
+    std::vector<std::uint32_t> inicio(numConjuntos);
+    std::vector<std::size_t> inicioCamada(n + 2, 0);
+    std::size_t total = 0;
+    for (std::size_t s = 0; s < numConjuntos; ++s) {
+        int k = __builtin_popcount(static_cast<unsigned>(s));
+        inicio[s] = static_cast<std::uint32_t>(total);
+        total += k;
+        inicioCamada[k + 1]++;
+    }
+    for (int k = 0; k <= n; ++k) {
+        inicioCamada[k + 1] += inicioCamada[k];
+    }
+    std::vector<std::uint32_t> porCamada(numConjuntos);
+    {
+        std::vector<std::size_t> proxima(inicioCamada.begin(), inicioCamada.end() - 1);
+        for (std::size_t s = 0; s < numConjuntos; ++s) {
+            porCamada[proxima[__builtin_popcount(static_cast<unsigned>(s))]++] = static_cast<std::uint32_t>(s);
+        }
+    }
+
+    std::vector<double> custo(total);
+    for (int i = 0; i < n; ++i) {
+        custo[inicio[1u << i]] = distancias[i + 1];
+    }
+
+    auto calcular = [&](std::size_t de, std::size_t ate) {
+        for (std::size_t p = de; p < ate; ++p) {
+            std::uint32_t conjunto = porCamada[p];
+            double* destino = &custo[inicio[conjunto]];
+            for (std::uint32_t restoI = conjunto; restoI != 0; restoI &= restoI - 1) {
+                int i = __builtin_ctz(restoI);
+                std::uint32_t anterior = conjunto & ~(1u << i);
+                const double* origem = &custo[inicio[anterior]];
+                const double* ate_i = &chegada[static_cast<std::size_t>(i) * n];
+                double melhor = std::numeric_limits<double>::infinity();
+                int posicao = 0;
+                for (std::uint32_t restoJ = anterior; restoJ != 0; restoJ &= restoJ - 1, ++posicao) {
+                    double valor = origem[posicao] + ate_i[__builtin_ctz(restoJ)];
+                    if (valor < melhor) {
+                        melhor = valor;
+                    }
+                }
+                *destino++ = melhor;
+            }
+        }
+    };
+    for (int k = 2; k <= n; ++k) {
+        std::size_t de = inicioCamada[k];
+        std::size_t tamanho = inicioCamada[k + 1] - de;
+        if (threads <= 1 || tamanho < MINIMO_CAMADA_PARALELA) {
+            calcular(de, de + tamanho);
+            continue;
+        }
+        int blocos = threads * 4;
+        executarEmParalelo(blocos, threads, [&](int b) {
+            calcular(de + tamanho * b / blocos, de + tamanho * (b + 1) / blocos);
+        });
+    }
+
+    // Melhor imóvel final (menor índice nos empates) e caminho de volta até o corretor
+    std::uint32_t conjunto = static_cast<std::uint32_t>(numConjuntos - 1);
+    const double* finais = &custo[inicio[conjunto]];
+    int atual = static_cast<int>(std::min_element(finais, finais + n) - finais);
+    std::vector<int> rota = {atual};
+    while (conjunto != (1u << atual)) {
+        double alvo = custo[inicio[conjunto] + posicaoNoConjunto(conjunto, atual)];
+        std::uint32_t anterior = conjunto & ~(1u << atual);
+        const double* origem = &custo[inicio[anterior]];
+        int posicao = 0;
+        for (std::uint32_t resto = anterior; resto != 0; resto &= resto - 1, ++posicao) {
+            int j = __builtin_ctz(resto);
+            if (origem[posicao] + chegada[static_cast<std::size_t>(atual) * n + j] == alvo) {
+                rota.push_back(j);
+                atual = j;
+                break;
+            }
+        }
+        conjunto = anterior;
+    }
+    std::reverse(rota.begin(), rota.end());
+    return rota;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file rota_exata.h
+ * @brief Caminho ótimo exato (Held-Karp) para rotas curtas
+ *
+ * Etapa opcional, ligada por --exact-max N: rotas com até N imóveis deixam
+ * de usar o vizinho mais próximo e recebem a ordem de menor distância total
+ * (caminho aberto que começa no corretor), por programação dinâmica sobre
+ * subconjuntos em O(n² 2^n). Rotas maiores continuam com a heurística.
+ *
+ * A tabela guarda, para cada conjunto S de imóveis e cada i ∈ S, o menor
+ * custo de sair do corretor, passar por S e terminar em i, com os valores
+ * de um mesmo conjunto lado a lado: n·2^(n-1) valores, 80 MiB com n = 20,
+ * o máximo aceito.
+ * Cada camada (conjuntos com o mesmo número de imóveis) só depende da
+ * anterior, e os seus conjuntos são divididos entre as threads.
+ */
+
+#ifndef ROTA_EXATA_H
+#define ROTA_EXATA_H
+
+#include <cstddef>
+#include <vector>
+
+/// Maior rota aceita por --exact-max (limita a tabela a 80 MiB por rota)
+constexpr int MAXIMO_ROTA_EXATA = 20;
+
+/**
+ * @brief Ordem de visita de menor distância total
+ *
+ * Empates ficam com o menor imóvel final e, em cada passo, com o menor
+ * antecessor, então o resultado não depende do número de threads.
+ *
+ * @param distancias Matriz (n + 1) x (n + 1) por linha: nó 0 é o corretor e
+ *        p + 1 é o imóvel na posição p (a coluna 0 não é usada)
+ * @param n Número de imóveis (1 a MAXIMO_ROTA_EXATA)
+ * @param threads Threads usadas em cada camada da programação dinâmica
+ * @return Posições (0 a n - 1) na ordem de visita
+ */
+std::vector<int> caminhoOtimo(const std::vector<double>& distancias, int n, int threads);
+
+/**
+ * @brief Caminho ótimo com as distâncias de um provedor (nó 0 = corretor)
+ * @tparam Provedor Política de distância (classe de distancia.h)
+ */
+template <typename Provedor>
+std::vector<int> rotaExata(int n, Provedor& provedor, int threads) {
+    std::vector<double> distancias(static_cast<std::size_t>(n + 1) * (n + 1), 0.0);
+    for (int u = 0; u <= n; ++u) {
+        for (int v = 1; v <= n; ++v) {
+            if (u != v) {
+                distancias[static_cast<std::size_t>(u) * (n + 1) + v] = provedor.distancia(u, v);
+            }
+        }
+    }
+    return caminhoOtimo(distancias, n, threads);
+}
+
+#endif
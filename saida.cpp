@@ -0,0 +1,183 @@
+/**
+ * @file saida.cpp
+ * @brief Implementação da escrita dos agendamentos
+ */
+
+#include "saida.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/// Tamanho do buffer de saída
+constexpr std::size_t TAMANHO_BUFFER = 1 << 20;
+
+/// Maior linha possível: cabeçalho do corretor ou visita em JSON com inteiros de 11 dígitos
+constexpr std::size_t MAIOR_LINHA = 96;
+
+/**
+ * Escreve um inteiro em p e devolve o fim
+ */
+inline char* escreverInteiro(char* p, int valor) {
+    return std::to_chars(p, p + 12, valor).ptr;
+}
+
+/**
+ * Escreve um número com pelo menos dois dígitos, como setfill('0') << setw(2)
+ */
+inline char* escreverDoisDigitos(char* p, int valor) {
+    if (valor >= 0 && valor < 100) {
+        p[0] = static_cast<char>('0' + valor / 10);
+        p[1] = static_cast<char>('0' + valor % 10);
+        return p + 2;
+    }
+    return escreverInteiro(p, valor);
+}
+
+inline char* escreverTexto(char* p, const char* texto, std::size_t tamanho) {
+    std::memcpy(p, texto, tamanho);
+    return p + tamanho;
+}
+
+template <std::size_t N>
+inline char* escreverLiteral(char* p, const char (&texto)[N]) {
+    return escreverTexto(p, texto, N - 1);
+}
+
+inline char* escreverHorario(char* p, const Agendamento& a) {
+    p = escreverDoisDigitos(p, a.hora);
+    *p++ = ':';
+    return escreverDoisDigitos(p, a.minuto);
+}
+
+/**
+ * Linhas do formato do enunciado
+ */
+inline char* linhaCorretorTexto(char* p, int corretorId) {
+    p = escreverLiteral(p, "Corretor ");
+    p = escreverInteiro(p, corretorId);
+    *p++ = '\n';
+    return p;
+}
+
+inline char* linhaVisitaTexto(char* p, const Agendamento& a) {
+    p = escreverHorario(p, a);
+    p = escreverLiteral(p, " Imóvel ");
+    p = escreverInteiro(p, a.imovelId);
+    *p++ = '\n';
+    return p;
+}
+
+} // namespace
+
+/**
+ * @brief Converte o nome usado em --format
+ */
+FormatoSaida formatoSaidaPorNome(const std::string& nome) {
+    if (nome == "text") {
+        return FormatoSaida::Texto;
+    } else if (nome == "csv") {
+        return FormatoSaida::Csv;
+    } else if (nome == "jsonl") {
+        return FormatoSaida::Jsonl;
+    }
+    throw std::runtime_error("Erro: valor inválido para --format: " + nome + " (use text, csv ou jsonl)");
+}
+
+EscritorAgenda::EscritorAgenda(FormatoSaida formato, std::FILE* destino)
+    : formato(formato), destino(destino), buffer(new char[TAMANHO_BUFFER]) {
+}
+
+EscritorAgenda::~EscritorAgenda() {
+    descarregar();
+}
+
+void EscritorAgenda::descarregar() {
+    if (usado > 0) {
+        std::fwrite(buffer.get(), 1, usado, destino);
+        totalEnviado += usado;
+        usado = 0;
+    }
+}
+
+/**
+ * Garante espaço contíguo para uma linha e devolve onde escrevê-la
+ */
+char* EscritorAgenda::reservar(std::size_t bytes) {
+    if (usado + bytes > TAMANHO_BUFFER) {
+        descarregar();
+    }
+    return buffer.get() + usado;
+}
+
+/**
+ * @brief Acrescenta a agenda de um corretor
+ */
+void EscritorAgenda::escreverCorretor(int corretorId, const std::vector<Agendamento>& agendamentos) {
+    char* p = reservar(MAIOR_LINHA * 2);
+    switch (formato) {
+        case FormatoSaida::Texto:
+            if (!primeiroCorretor) {
+                *p++ = '\n';
+            }
+            p = linhaCorretorTexto(p, corretorId);
+            usado = static_cast<std::size_t>(p - buffer.get());
+            for (const Agendamento& a : agendamentos) {
+                p = linhaVisitaTexto(reservar(MAIOR_LINHA), a);
+                usado = static_cast<std::size_t>(p - buffer.get());
+            }
+            break;
+        case FormatoSaida::Csv:
+            if (primeiroCorretor) {
+                p = escreverLiteral(p, "corretor,horario,imovel\n");
+                usado = static_cast<std::size_t>(p - buffer.get());
+            }
+            for (const Agendamento& a : agendamentos) {
+                p = reservar(MAIOR_LINHA);
+                p = escreverInteiro(p, corretorId);
+                *p++ = ',';
+                p = escreverHorario(p, a);
+                *p++ = ',';
+                p = escreverInteiro(p, a.imovelId);
+                *p++ = '\n';
+                usado = static_cast<std::size_t>(p - buffer.get());
+            }
+            break;
+        case FormatoSaida::Jsonl:
+            for (const Agendamento& a : agendamentos) {
+                p = reservar(MAIOR_LINHA);
+                p = escreverLiteral(p, "{\"corretor\":");
+                p = escreverInteiro(p, corretorId);
+                p = escreverLiteral(p, ",\"horario\":\"");
+                p = escreverHorario(p, a);
+                p = escreverLiteral(p, "\",\"imovel\":");
+                p = escreverInteiro(p, a.imovelId);
+                p = escreverLiteral(p, "}\n");
+                usado = static_cast<std::size_t>(p - buffer.get());
+            }
+            break;
+    }
+    primeiroCorretor = false;
+}
+
+/**
+ * @brief Envia o buffer e confirma que a escrita não falhou
+ */
+void EscritorAgenda::finalizar() {
+    descarregar();
+    if (std::fflush(destino) != 0 || std::ferror(destino)) {
+        throw std::runtime_error("Erro: falha ao escrever a saída");
+    }
+}
+
+/**
+ * @brief Acrescenta a um texto o bloco de um corretor no formato do enunciado
+ */
+void anexarAgendaTexto(std::string& destino, int corretorId, const std::vector<Agendamento>& agendamentos) {
+    char linha[MAIOR_LINHA];
+    destino.append(linha, linhaCorretorTexto(linha, corretorId));
+    for (const Agendamento& a : agendamentos) {
+        destino.append(linha, linhaVisitaTexto(linha, a));
+    }
+}
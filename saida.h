@@ -0,0 +1,100 @@
+/**
+ * @file saida.h
+ * @brief Escrita dos agendamentos com buffer próprio e formatação manual
+ *
+ * Substitui a impressão linha a linha com std::cout, setw/setfill e
+ * std::endl: as linhas são montadas num buffer de 1 MiB, com os números
+ * convertidos à mão, e o buffer só é enviado quando enche ou no fim.
+ *
+ * Formatos (--format):
+ *   - text: o formato do enunciado ("Corretor N" e "HH:MM Imóvel X",
+ *     blocos separados por uma linha vazia); é o padrão;
+ *   - csv: cabeçalho "corretor,horario,imovel" e uma linha por visita;
+ *   - jsonl: um objeto {"corretor":N,"horario":"HH:MM","imovel":X} por linha.
+ */
+
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "agendamento.h"
+
+/**
+ * @enum FormatoSaida
+ * @brief Formato da listagem dos agendamentos
+ */
+enum class FormatoSaida {
+    Texto, ///< Formato do enunciado
+    Csv,   ///< Valores separados por vírgula, com cabeçalho
+    Jsonl  ///< JSON Lines
+};
+
+/**
+ * @brief Converte o nome usado em --format ("text", "csv", "jsonl")
+ * @throws std::runtime_error se o nome não for reconhecido
+ */
+FormatoSaida formatoSaidaPorNome(const std::string& nome);
+
+/**
+ * @class EscritorAgenda
+ * @brief Escreve os agendamentos de vários corretores num arquivo, em blocos
+ */
+class EscritorAgenda {
+public:
+    /**
+     * @param formato Formato da listagem
+     * @param destino Arquivo de saída (por padrão, a saída padrão)
+     */
+    explicit EscritorAgenda(FormatoSaida formato, std::FILE* destino = stdout);
+
+    /**
+     * @brief Envia o que restar no buffer (sem verificar erros; use finalizar)
+     */
+    ~EscritorAgenda();
+
+    EscritorAgenda(const EscritorAgenda&) = delete;
+    EscritorAgenda& operator=(const EscritorAgenda&) = delete;
+
+    /**
+     * @brief Acrescenta a agenda de um corretor
+     * @param corretorId ID do corretor
+     * @param agendamentos Visitas na ordem em que acontecem
+     */
+    void escreverCorretor(int corretorId, const std::vector<Agendamento>& agendamentos);
+
+    /**
+     * @brief Envia o buffer e confirma que a escrita não falhou
+     * @throws std::runtime_error se houver erro de escrita
+     */
+    void finalizar();
+
+    /**
+     * @brief Bytes produzidos até agora
+     */
+    std::size_t bytesEscritos() const { return totalEnviado + usado; }
+
+private:
+    FormatoSaida formato;
+    std::FILE* destino;
+    std::unique_ptr<char[]> buffer;
+    std::size_t usado = 0;
+    std::size_t totalEnviado = 0;
+    bool primeiroCorretor = true;
+
+    void descarregar();
+    char* reservar(std::size_t bytes);
+};
+
+/**
+ * @brief Acrescenta a um texto o bloco de um corretor no formato do enunciado
+ * @param destino Texto que recebe o bloco
+ * @param corretorId ID do corretor
+ * @param agendamentos Visitas na ordem em que acontecem
+ */
+void anexarAgendaTexto(std::string& destino, int corretorId, const std::vector<Agendamento>& agendamentos);
+
+#endif
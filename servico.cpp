@@ -0,0 +1,241 @@
+/**
+ * @file servico.cpp
+ * @brief Implementação do modo serviço (entrada padrão ou socket Unix)
+ */
+
+#include "servico.h"
+#include "dados.h"
+#include "leitor.h"
+#include "saida.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+/// Resultado de um comando para o laço de atendimento
+enum class Continuacao {
+    Seguir,          ///< Aguarda o próximo comando
+    EncerrarSessao,  ///< "quit" ou fim da entrada
+    EncerrarServico  ///< "shutdown"
+};
+
+/**
+ * Bloco de um corretor no formato da saída principal
+ */
+std::string agendaComoTexto(const AgendaIncremental& agenda, int corretorId) {
+    std::string bloco;
+    anexarAgendaTexto(bloco, corretorId, agenda.agenda(corretorId));
+    return bloco;
+}
+
+/**
+ * Lê linhas de um descritor, guardando o que sobrar para a próxima leitura
+ */
+class LinhasDoDescritor {
+public:
+    explicit LinhasDoDescritor(int fd) : fd(fd) {}
+
+    bool proxima(std::string& linha) {
+        for (;;) {
+            size_t fimLinha = pendente.find('\n');
+            if (fimLinha != std::string::npos) {
+                linha.assign(pendente, 0, fimLinha);
+                pendente.erase(0, fimLinha + 1);
+                return true;
+            }
+            char bloco[4096];
+            ssize_t lidos = read(fd, bloco, sizeof(bloco));
+            if (lidos < 0 && errno == EINTR) {
+                continue;
+            }
+            if (lidos <= 0) {
+                // Última linha sem '\n'
+                linha.swap(pendente);
+                pendente.clear();
+                return !linha.empty();
+            }
+            pendente.append(bloco, static_cast<size_t>(lidos));
+        }
+    }
+
+private:
+    int fd;
+    std::string pendente;
+};
+
+/**
+ * Escreve todo o texto; num socket, uma conexão fechada pelo cliente apenas
+ * encerra a sessão (sem SIGPIPE)
+ */
+bool escreverTudo(int fd, const std::string& texto, bool ehSocket) {
+    size_t enviados = 0;
+    while (enviados < texto.size()) {
+        ssize_t n = ehSocket ? send(fd, texto.data() + enviados, texto.size() - enviados, MSG_NOSIGNAL)
+                             : write(fd, texto.data() + enviados, texto.size() - enviados);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        enviados += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * Executa um comando e monta a resposta (sem a linha vazia final)
+ */
+Continuacao executarComando(AgendaIncremental& agenda, int numClientes,
+                            const std::string& linha, std::ostringstream& resposta) {
+    size_t inicio = linha.find_first_not_of(" \t");
+    size_t fimComando = linha.find_first_of(" \t", inicio);
+    std::string comando = linha.substr(inicio, fimComando == std::string::npos ? std::string::npos : fimComando - inicio);
+    const char* argumentos = linha.data() + (fimComando == std::string::npos ? linha.size() : fimComando);
+    LeitorEntrada leitor(argumentos, static_cast<size_t>(linha.data() + linha.size() - argumentos));
+
+    if (comando == "add-imovel") {
+        int corretorId = agenda.adicionarImovel(lerImovel(leitor, agenda.proximoImovelId(), numClientes, agenda.arenaTextos()));
+        resposta << "Imóvel " << agenda.proximoImovelId() - 1 << " agendado para o Corretor " << corretorId << "\n";
+        resposta << agendaComoTexto(agenda, corretorId);
+    } else if (comando == "remove-imovel") {
+        int imovelId;
+        if (!leitor.lerInteiro(imovelId)) {
+            throw std::runtime_error("Erro: remove-imovel requer o ID do imóvel");
+        }
+        int corretorId = agenda.removerImovel(imovelId);
+        resposta << "Imóvel " << imovelId << " removido do Corretor " << corretorId << "\n";
+        resposta << agendaComoTexto(agenda, corretorId);
+    } else if (comando == "add-corretor") {
+        int corretorId = agenda.adicionarCorretor(lerCorretor(leitor, agenda.proximoCorretorId(), agenda.arenaTextos()));
+        resposta << "Corretor " << corretorId << " adicionado\n";
+    } else if (comando == "show") {
+        int corretorId;
+        if (!leitor.lerInteiro(corretorId)) {
+            throw std::runtime_error("Erro: show requer o ID do corretor");
+        }
+        resposta << agendaComoTexto(agenda, corretorId);
+    } else if (comando == "total") {
+        resposta << "Distância total percorrida " << std::fixed << std::setprecision(2)
+                 << agenda.distanciaTotal() << " km\n";
+    } else if (comando == "quit") {
+        return Continuacao::EncerrarSessao;
+    } else if (comando == "shutdown") {
+        return Continuacao::EncerrarServico;
+    } else {
+        throw std::runtime_error("Erro: comando desconhecido: " + comando);
+    }
+    return Continuacao::Seguir;
+}
+
+/**
+ * Atende uma sessão: lê comandos de fdEntrada e responde em fdSaida
+ *
+ * Linhas vazias e iniciadas por '#' são ignoradas. Um comando inválido
+ * recebe "Erro: ..." e não altera as rotas.
+ */
+Continuacao atenderSessao(AgendaIncremental& agenda, int numClientes,
+                          int fdEntrada, int fdSaida, bool ehSocket) {
+    LinhasDoDescritor linhas(fdEntrada);
+    std::string linha;
+    while (linhas.proxima(linha)) {
+        if (!linha.empty() && linha.back() == '\r') {
+            linha.pop_back();
+        }
+        size_t inicio = linha.find_first_not_of(" \t");
+        if (inicio == std::string::npos || linha[inicio] == '#') {
+            continue;
+        }
+
+        std::ostringstream resposta;
+        Continuacao continuacao = Continuacao::Seguir;
+        try {
+            continuacao = executarComando(agenda, numClientes, linha, resposta);
+        } catch (const std::exception& e) {
+            resposta.str("");
+            resposta << e.what() << "\n";
+        }
+        if (continuacao != Continuacao::Seguir) {
+            return continuacao;
+        }
+        resposta << "\n";
+        if (!escreverTudo(fdSaida, resposta.str(), ehSocket)) {
+            return Continuacao::EncerrarSessao;
+        }
+    }
+    return Continuacao::EncerrarSessao;
+}
+
+/**
+ * Escuta no socket Unix e atende as conexões em sequência até "shutdown"
+ */
+void escutarSocket(AgendaIncremental& agenda, int numClientes, const std::string& caminho) {
+    sockaddr_un endereco{};
+    endereco.sun_family = AF_UNIX;
+    if (caminho.size() >= sizeof(endereco.sun_path)) {
+        throw std::runtime_error("Erro: caminho do socket muito longo: " + caminho);
+    }
+    std::memcpy(endereco.sun_path, caminho.c_str(), caminho.size() + 1);
+
+    // Um socket esquecido por uma execução anterior é substituído; qualquer outro arquivo, não
+    struct stat info;
+    if (lstat(caminho.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            throw std::runtime_error("Erro: " + caminho + " já existe e não é um socket");
+        }
+        unlink(caminho.c_str());
+    }
+
+    int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0) {
+        throw std::runtime_error("Erro: não foi possível criar o socket: " + std::string(std::strerror(errno)));
+    }
+    if (bind(servidor, reinterpret_cast<const sockaddr*>(&endereco), sizeof(endereco)) != 0 ||
+        listen(servidor, 16) != 0) {
+        std::string motivo = std::strerror(errno);
+        close(servidor);
+        throw std::runtime_error("Erro: não foi possível escutar em " + caminho + ": " + motivo);
+    }
+    std::cerr << "Serviço escutando em " << caminho << std::endl;
+
+    for (;;) {
+        int conexao = accept(servidor, nullptr, nullptr);
+        if (conexao < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+        Continuacao continuacao = atenderSessao(agenda, numClientes, conexao, conexao, true);
+        close(conexao);
+        if (continuacao == Continuacao::EncerrarServico) {
+            break;
+        }
+    }
+    close(servidor);
+    unlink(caminho.c_str());
+}
+
+} // namespace
+
+/**
+ * @brief Atende comandos até o fim da entrada ou até "shutdown"
+ */
+void executarServico(AgendaIncremental& agenda, int numClientes, const std::string& caminhoSocket) {
+    if (caminhoSocket.empty()) {
+        std::cout.flush();
+        atenderSessao(agenda, numClientes, 0, 1, false);
+    } else {
+        escutarSocket(agenda, numClientes, caminhoSocket);
+    }
+}
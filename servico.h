@@ -0,0 +1,37 @@
+/**
+ * @file servico.h
+ * @brief Modo serviço: atualizações incrementais por comandos de texto
+ *
+ * Um comando por linha; cada resposta termina com uma linha vazia.
+ *
+ *     add-imovel TIPO PROPRIETARIO LAT LON PRECO ENDERECO
+ *     remove-imovel ID
+ *     add-corretor TELEFONE AVALIADOR LAT LON NOME
+ *     show ID            (agenda atual do corretor)
+ *     total              (distância total percorrida)
+ *     quit               (encerra a sessão)
+ *     shutdown           (encerra o serviço)
+ *
+ * Os campos de add-imovel e add-corretor seguem o formato das linhas da
+ * entrada e passam pelas mesmas validações. As respostas de add-imovel e
+ * remove-imovel trazem apenas a agenda do corretor afetado.
+ */
+
+#ifndef SERVICO_H
+#define SERVICO_H
+
+#include <string>
+#include "incremental.h"
+
+/**
+ * @brief Atende comandos até o fim da entrada ou até "shutdown"
+ * @param agenda Rotas já geradas
+ * @param numClientes Número de clientes cadastrados (limite do ID do proprietário)
+ * @param caminhoSocket Vazio para ler comandos da entrada padrão e responder
+ *        na saída padrão; caso contrário, caminho do socket Unix onde escutar
+ *        (as conexões são atendidas uma de cada vez)
+ * @throws std::runtime_error se o socket não puder ser criado
+ */
+void executarServico(AgendaIncremental& agenda, int numClientes, const std::string& caminhoSocket);
+
+#endif
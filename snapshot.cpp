@@ -0,0 +1,301 @@
+/**
+ * @file snapshot.cpp
+ * @brief Implementação da gravação e do carregamento de snapshots
+ */
+
+#include "snapshot.h"
+#include "mapeamento.h"
+#include "metricas.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+constexpr char MAGICO[8] = {'I', 'M', 'O', 'B', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t VERSAO_SNAPSHOT = 1;
+constexpr std::uint32_t MARCA_ORDEM_BYTES = 0x01020304;
+
+/**
+ * Cabeçalho fixo de 64 bytes no início do arquivo
+ */
+struct Cabecalho {
+    char magico[8];
+    std::uint32_t versao;
+    std::uint32_t marca;
+    std::uint64_t numCorretores;
+    std::uint64_t numClientes;
+    std::uint64_t numImoveis;
+    std::uint64_t numTextos;
+    std::uint64_t bytesTextos;
+    std::uint64_t tamanhoArquivo;
+};
+static_assert(sizeof(Cabecalho) == 64, "cabeçalho do snapshot deve ter 64 bytes");
+
+/**
+ * Posição (em bytes desde o início do arquivo) de cada coluna
+ */
+struct Layout {
+    std::uint64_t corretorLat, corretorLon, corretorAvaliador, corretorTelefone, corretorNome;
+    std::uint64_t clienteTelefone, clienteNome;
+    std::uint64_t imovelLat, imovelLon, imovelPreco, imovelProprietario, imovelTipo, imovelEndereco;
+    std::uint64_t textosDeslocamentos, textosBytes;
+    std::uint64_t total;
+};
+
+/**
+ * Calcula o layout a partir dos contadores; escrita e leitura usam a mesma função
+ */
+Layout calcularLayout(const Cabecalho& c) {
+    Layout l{};
+    std::uint64_t pos = sizeof(Cabecalho);
+    auto coluna = [&pos](std::uint64_t& campo, std::uint64_t bytes) {
+        campo = pos;
+        pos += (bytes + 7) & ~std::uint64_t(7);
+    };
+    coluna(l.corretorLat, c.numCorretores * sizeof(double));
+    coluna(l.corretorLon, c.numCorretores * sizeof(double));
+    coluna(l.corretorAvaliador, c.numCorretores * sizeof(std::uint8_t));
+    coluna(l.corretorTelefone, c.numCorretores * sizeof(std::uint32_t));
+    coluna(l.corretorNome, c.numCorretores * sizeof(std::uint32_t));
+    coluna(l.clienteTelefone, c.numClientes * sizeof(std::uint32_t));
+    coluna(l.clienteNome, c.numClientes * sizeof(std::uint32_t));
+    coluna(l.imovelLat, c.numImoveis * sizeof(double));
+    coluna(l.imovelLon, c.numImoveis * sizeof(double));
+    coluna(l.imovelPreco, c.numImoveis * sizeof(double));
+    coluna(l.imovelProprietario, c.numImoveis * sizeof(std::int32_t));
+    coluna(l.imovelTipo, c.numImoveis * sizeof(std::uint8_t));
+    coluna(l.imovelEndereco, c.numImoveis * sizeof(std::uint32_t));
+    coluna(l.textosDeslocamentos, (c.numTextos + 1) * sizeof(std::uint64_t));
+    coluna(l.textosBytes, c.bytesTextos);
+    l.total = pos;
+    return l;
+}
+
+/**
+ * Repositório de textos sendo montado para gravação
+ */
+struct RepositorioTextos {
+    std::vector<std::uint64_t> deslocamentos{0};
+    std::string bytes;
+
+    std::uint32_t adicionar(std::string_view texto) {
+        bytes.append(texto);
+        deslocamentos.push_back(bytes.size());
+        return static_cast<std::uint32_t>(deslocamentos.size() - 2);
+    }
+};
+
+/**
+ * Grava uma coluna na posição indicada pelo layout, completando com zeros
+ */
+template <typename T>
+void gravarColuna(std::ofstream& arquivo, std::uint64_t posicao, const std::vector<T>& valores) {
+    static const char zeros[8] = {};
+    std::uint64_t atual = static_cast<std::uint64_t>(arquivo.tellp());
+    arquivo.write(zeros, static_cast<std::streamsize>(posicao - atual));
+    arquivo.write(reinterpret_cast<const char*>(valores.data()),
+                  static_cast<std::streamsize>(valores.size() * sizeof(T)));
+}
+
+/**
+ * Ponteiro tipado para uma coluna do arquivo carregado
+ */
+template <typename T>
+const T* coluna(const char* base, std::uint64_t posicao) {
+    return reinterpret_cast<const T*>(base + posicao);
+}
+
+void invalido(const std::string& motivo) {
+    throw std::runtime_error("Erro: snapshot inválido: " + motivo);
+}
+
+/**
+ * Mesmos intervalos da leitura da entrada (dados.cpp); a negação também
+ * rejeita NaN
+ */
+bool coordenadaValida(double lat, double lon) {
+    return lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0;
+}
+
+} // namespace
+
+/**
+ * @brief Grava a base de dados num arquivo de snapshot
+ */
+void exportarSnapshot(const std::string& caminho,
+                      const std::vector<Corretor>& corretores,
+                      const std::vector<Cliente>& clientes,
+                      const std::vector<Imovel>& imoveis) {
+    RepositorioTextos textos;
+
+    std::vector<double> corretorLat, corretorLon;
+    std::vector<std::uint8_t> corretorAvaliador;
+    std::vector<std::uint32_t> corretorTelefone, corretorNome;
+    for (const auto& corretor : corretores) {
+        corretorLat.push_back(corretor.latitude);
+        corretorLon.push_back(corretor.longitude);
+        corretorAvaliador.push_back(corretor.isAvaliador() ? 1 : 0);
+        corretorTelefone.push_back(textos.adicionar(corretor.telefone));
+        corretorNome.push_back(textos.adicionar(corretor.nome));
+    }
+
+    std::vector<std::uint32_t> clienteTelefone, clienteNome;
+    for (const auto& cliente : clientes) {
+        clienteTelefone.push_back(textos.adicionar(cliente.telefone));
+        clienteNome.push_back(textos.adicionar(cliente.nome));
+    }
+
+    std::vector<double> imovelLat, imovelLon, imovelPreco;
+    std::vector<std::int32_t> imovelProprietario;
+    std::vector<std::uint8_t> imovelTipo;
+    std::vector<std::uint32_t> imovelEndereco;
+    for (const auto& imovel : imoveis) {
+        imovelLat.push_back(imovel.latitude);
+        imovelLon.push_back(imovel.longitude);
+        imovelPreco.push_back(imovel.preco);
+        imovelProprietario.push_back(imovel.proprietarioId);
+        imovelTipo.push_back(static_cast<std::uint8_t>(imovel.tipo));
+        imovelEndereco.push_back(textos.adicionar(imovel.endereco));
+    }
+
+    Cabecalho cabecalho{};
+    std::memcpy(cabecalho.magico, MAGICO, sizeof(MAGICO));
+    cabecalho.versao = VERSAO_SNAPSHOT;
+    cabecalho.marca = MARCA_ORDEM_BYTES;
+    cabecalho.numCorretores = corretores.size();
+    cabecalho.numClientes = clientes.size();
+    cabecalho.numImoveis = imoveis.size();
+    cabecalho.numTextos = textos.deslocamentos.size() - 1;
+    cabecalho.bytesTextos = textos.bytes.size();
+    Layout layout = calcularLayout(cabecalho);
+    cabecalho.tamanhoArquivo = layout.total;
+
+    std::ofstream arquivo(caminho, std::ios::binary | std::ios::trunc);
+    if (!arquivo) {
+        throw std::runtime_error("Erro: não foi possível criar " + caminho);
+    }
+    arquivo.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+    gravarColuna(arquivo, layout.corretorLat, corretorLat);
+    gravarColuna(arquivo, layout.corretorLon, corretorLon);
+    gravarColuna(arquivo, layout.corretorAvaliador, corretorAvaliador);
+    gravarColuna(arquivo, layout.corretorTelefone, corretorTelefone);
+    gravarColuna(arquivo, layout.corretorNome, corretorNome);
+    gravarColuna(arquivo, layout.clienteTelefone, clienteTelefone);
+    gravarColuna(arquivo, layout.clienteNome, clienteNome);
+    gravarColuna(arquivo, layout.imovelLat, imovelLat);
+    gravarColuna(arquivo, layout.imovelLon, imovelLon);
+    gravarColuna(arquivo, layout.imovelPreco, imovelPreco);
+    gravarColuna(arquivo, layout.imovelProprietario, imovelProprietario);
+    gravarColuna(arquivo, layout.imovelTipo, imovelTipo);
+    gravarColuna(arquivo, layout.imovelEndereco, imovelEndereco);
+    gravarColuna(arquivo, layout.textosDeslocamentos, textos.deslocamentos);
+    gravarColuna(arquivo, layout.textosBytes, std::vector<char>(textos.bytes.begin(), textos.bytes.end()));
+    gravarColuna(arquivo, layout.total, std::vector<char>());
+    if (!arquivo) {
+        throw std::runtime_error("Erro: falha ao gravar " + caminho);
+    }
+}
+
+/**
+ * @brief Carrega a base de dados de um arquivo de snapshot
+ * 
+ * O arquivo é mapeado e as colunas são lidas no próprio mapeamento. Antes
+ * de criar os objetos, confere cabeçalho, tamanho, coordenadas e
+ * referências entre colunas, para que um arquivo truncado ou corrompido gere erro. Os bytes
+ * do repositório de textos são copiados para a arena numa única operação
+ * e as entidades apontam para trechos dessa cópia.
+ */
+void carregarSnapshot(const std::string& caminho,
+                      std::vector<Corretor>& corretores,
+                      std::vector<Cliente>& clientes,
+                      std::vector<Imovel>& imoveis,
+                      ArenaTextos& textos) {
+    ArquivoMapeado arquivo(caminho);
+    METRICA_CONTAR(bytesLidos, arquivo.tamanho());
+    const char* base = arquivo.dados();
+
+    if (arquivo.tamanho() < sizeof(Cabecalho)) {
+        invalido("arquivo muito pequeno");
+    }
+    Cabecalho cabecalho;
+    std::memcpy(&cabecalho, base, sizeof(cabecalho));
+    if (std::memcmp(cabecalho.magico, MAGICO, sizeof(MAGICO)) != 0) {
+        invalido("assinatura desconhecida");
+    }
+    if (cabecalho.marca != MARCA_ORDEM_BYTES) {
+        invalido("ordem de bytes diferente da máquina");
+    }
+    if (cabecalho.versao != VERSAO_SNAPSHOT) {
+        invalido("versão " + std::to_string(cabecalho.versao) + " não suportada");
+    }
+    // Contadores maiores que o arquivo fariam a soma do layout dar a volta
+    if (cabecalho.numCorretores > arquivo.tamanho() || cabecalho.numClientes > arquivo.tamanho() ||
+        cabecalho.numImoveis > arquivo.tamanho() || cabecalho.numTextos > arquivo.tamanho() ||
+        cabecalho.bytesTextos > arquivo.tamanho()) {
+        invalido("tamanho não confere com o cabeçalho");
+    }
+    Layout layout = calcularLayout(cabecalho);
+    if (cabecalho.tamanhoArquivo != arquivo.tamanho() || layout.total != arquivo.tamanho()) {
+        invalido("tamanho não confere com o cabeçalho");
+    }
+
+    const std::uint64_t* deslocamentos = coluna<std::uint64_t>(base, layout.textosDeslocamentos);
+    const char* bytesTextos = textos.guardar(std::string_view(base + layout.textosBytes, cabecalho.bytesTextos)).data();
+    for (std::uint64_t i = 0; i < cabecalho.numTextos; ++i) {
+        if (deslocamentos[i] > deslocamentos[i + 1] || deslocamentos[i + 1] > cabecalho.bytesTextos) {
+            invalido("repositório de textos corrompido");
+        }
+    }
+    auto texto = [&](std::uint32_t indice) {
+        if (indice >= cabecalho.numTextos) {
+            invalido("referência de texto fora do repositório");
+        }
+        return std::string_view(bytesTextos + deslocamentos[indice],
+                                deslocamentos[indice + 1] - deslocamentos[indice]);
+    };
+
+    const double* corretorLat = coluna<double>(base, layout.corretorLat);
+    const double* corretorLon = coluna<double>(base, layout.corretorLon);
+    const std::uint8_t* corretorAvaliador = coluna<std::uint8_t>(base, layout.corretorAvaliador);
+    const std::uint32_t* corretorTelefone = coluna<std::uint32_t>(base, layout.corretorTelefone);
+    const std::uint32_t* corretorNome = coluna<std::uint32_t>(base, layout.corretorNome);
+    corretores.reserve(cabecalho.numCorretores);
+    for (std::uint64_t i = 0; i < cabecalho.numCorretores; ++i) {
+        if (!coordenadaValida(corretorLat[i], corretorLon[i])) {
+            invalido("coordenadas do corretor " + std::to_string(i + 1) + " fora do intervalo");
+        }
+        corretores.emplace_back(static_cast<int>(i + 1), texto(corretorTelefone[i]), corretorAvaliador[i] != 0,
+                                corretorLat[i], corretorLon[i], texto(corretorNome[i]));
+    }
+
+    const std::uint32_t* clienteTelefone = coluna<std::uint32_t>(base, layout.clienteTelefone);
+    const std::uint32_t* clienteNome = coluna<std::uint32_t>(base, layout.clienteNome);
+    clientes.reserve(cabecalho.numClientes);
+    for (std::uint64_t i = 0; i < cabecalho.numClientes; ++i) {
+        clientes.emplace_back(static_cast<int>(i + 1), texto(clienteTelefone[i]), texto(clienteNome[i]));
+    }
+
+    const double* imovelLat = coluna<double>(base, layout.imovelLat);
+    const double* imovelLon = coluna<double>(base, layout.imovelLon);
+    const double* imovelPreco = coluna<double>(base, layout.imovelPreco);
+    const std::int32_t* imovelProprietario = coluna<std::int32_t>(base, layout.imovelProprietario);
+    const std::uint8_t* imovelTipo = coluna<std::uint8_t>(base, layout.imovelTipo);
+    const std::uint32_t* imovelEndereco = coluna<std::uint32_t>(base, layout.imovelEndereco);
+    imoveis.reserve(cabecalho.numImoveis);
+    for (std::uint64_t i = 0; i < cabecalho.numImoveis; ++i) {
+        if (!coordenadaValida(imovelLat[i], imovelLon[i])) {
+            invalido("coordenadas do imóvel " + std::to_string(i + 1) + " fora do intervalo");
+        }
+        if (imovelTipo[i] > Terreno) {
+            invalido("tipo de imóvel desconhecido");
+        }
+        if (imovelProprietario[i] <= 0 || static_cast<std::uint64_t>(imovelProprietario[i]) > cabecalho.numClientes) {
+            invalido("ID do proprietário fora do intervalo");
+        }
+        imoveis.emplace_back(static_cast<int>(i + 1), static_cast<TipoImovel>(imovelTipo[i]), imovelProprietario[i],
+                             imovelLat[i], imovelLon[i], imovelPreco[i], texto(imovelEndereco[i]));
+    }
+}
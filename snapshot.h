@@ -0,0 +1,65 @@
+/**
+ * @file snapshot.h
+ * @brief Formato binário colunar para salvar e carregar a base de dados
+ * 
+ * Um snapshot guarda corretores, clientes e imóveis já validados, evitando
+ * interpretar o texto da entrada a cada execução.
+ * 
+ * Layout (versão 1, ordem de bytes da máquina, verificada pelo campo marca):
+ *   - Cabeçalho de 64 bytes: "IMOBSNAP", versão, marca 0x01020304, número de
+ *     corretores, clientes, imóveis e textos, bytes de texto e tamanho total.
+ *   - Colunas de largura fixa, cada uma alinhada em 8 bytes:
+ *       corretores: latitude f64, longitude f64, avaliador u8, telefone u32, nome u32
+ *       clientes:   telefone u32, nome u32
+ *       imóveis:    latitude f64, longitude f64, preço f64, proprietário i32,
+ *                   tipo u8, endereço u32
+ *   - Repositório de textos: deslocamentos u64[numTextos + 1] seguidos dos bytes.
+ *     As colunas de texto guardam o índice do texto nesse repositório.
+ * 
+ * Como as posições de todas as colunas decorrem só dos contadores do
+ * cabeçalho, o arquivo pode ser mapeado e lido diretamente.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include "corretor.h"
+#include "cliente.h"
+#include "imovel.h"
+#include "textos.h"
+
+/**
+ * @brief Grava a base de dados num arquivo de snapshot
+ * @param caminho Arquivo de destino
+ * @param corretores Corretores lidos
+ * @param clientes Clientes lidos
+ * @param imoveis Imóveis lidos
+ * @throws std::runtime_error se o arquivo não puder ser gravado
+ */
+void exportarSnapshot(const std::string& caminho,
+                      const std::vector<Corretor>& corretores,
+                      const std::vector<Cliente>& clientes,
+                      const std::vector<Imovel>& imoveis);
+
+/**
+ * @brief Carrega a base de dados de um arquivo de snapshot
+ * 
+ * Os objetos são criados na mesma ordem da entrada original, então recebem
+ * os mesmos IDs.
+ * 
+ * @param caminho Arquivo de origem
+ * @param corretores Recebe os corretores
+ * @param clientes Recebe os clientes
+ * @param imoveis Recebe os imóveis
+ * @param textos Arena que recebe o repositório de textos (copiado de uma vez)
+ * @throws std::runtime_error se o arquivo não existir ou estiver corrompido
+ */
+void carregarSnapshot(const std::string& caminho,
+                      std::vector<Corretor>& corretores,
+                      std::vector<Cliente>& clientes,
+                      std::vector<Imovel>& imoveis,
+                      ArenaTextos& textos);
+
+#endif
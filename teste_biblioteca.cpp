@@ -0,0 +1,178 @@
+/**
+ * @file teste_biblioteca.cpp
+ * @brief Teste de estresse da libimobiliaria com chamadas simultâneas
+ *
+ * Carrega as bases dos testes 1 a 4 e uma base sintética maior, confere a
+ * saída das bases de teste com as saídas esperadas e calcula, numa thread
+ * só, a referência de cada combinação de base e opções. Em seguida, várias
+ * threads chamam agendarAvaliacoes ao mesmo tempo, em ordens diferentes, e
+ * cada resultado precisa ser idêntico à sua referência.
+ *
+ * Uso: teste_biblioteca [threads] [chamadas por thread]
+ * Termina com código 0 se tudo conferir e 1 caso contrário.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dados.h"
+#include "imobiliaria.h"
+#include "leitor.h"
+#include "saida.h"
+
+namespace {
+
+/**
+ * Agendas no formato do enunciado, como o programa as imprimiria
+ */
+std::string emTexto(const std::vector<AgendaCorretor>& agendas) {
+    std::string texto;
+    for (std::size_t i = 0; i < agendas.size(); ++i) {
+        if (i > 0) {
+            texto += '\n';
+        }
+        anexarAgendaTexto(texto, agendas[i].corretorId, agendas[i].visitas);
+    }
+    return texto;
+}
+
+std::string lerArquivo(const std::string& caminho) {
+    std::ifstream arquivo(caminho, std::ios::binary);
+    if (!arquivo) {
+        throw std::runtime_error("não foi possível abrir " + caminho);
+    }
+    std::ostringstream conteudo;
+    conteudo << arquivo.rdbuf();
+    return conteudo.str();
+}
+
+/**
+ * Base sintética: avaliadores e imóveis espalhados numa área urbana, com
+ * alguns imóveis repetidos no mesmo ponto para exercitar os desempates
+ */
+void gerarBase(BaseDados& base, int numCorretores, int numImoveis, std::uint32_t semente) {
+    auto aleatorio = [&semente]() {
+        semente = semente * 1664525u + 1013904223u;
+        return (semente >> 8) / 16777216.0;
+    };
+    std::string_view texto = base.textos.guardar("x");
+    for (int i = 1; i <= numCorretores; ++i) {
+        base.corretores.emplace_back(i, texto, i % 4 != 0, -23.6 + 0.2 * aleatorio(), -46.7 + 0.2 * aleatorio(), texto);
+    }
+    for (int i = 1; i <= numImoveis; ++i) {
+        double lat = -23.6 + 0.2 * aleatorio();
+        double lon = -46.7 + 0.2 * aleatorio();
+        if (i % 10 == 0) {
+            lat = base.imoveis[i - 2].latitude;
+            lon = base.imoveis[i - 2].longitude;
+        }
+        base.imoveis.emplace_back(i, static_cast<TipoImovel>(i % 3), 1, lat, lon, 1000.0 * i, texto);
+    }
+}
+
+/**
+ * Uma chamada a repetir: base e opções, com o resultado de referência
+ */
+struct Caso {
+    const BaseDados* base;
+    ParametrosAgenda parametros;
+    std::string referencia;
+};
+
+std::string executar(const Caso& caso) {
+    const BaseDados& base = *caso.base;
+    return emTexto(agendarAvaliacoes(base.corretores.data(), base.corretores.size(),
+                                     base.imoveis.data(), base.imoveis.size(), caso.parametros));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int numThreads = argc > 1 ? std::stoi(argv[1]) : 8;
+    int chamadas = argc > 2 ? std::stoi(argv[2]) : 40;
+    try {
+        std::vector<BaseDados> bases(5);
+        for (int t = 0; t < 4; ++t) {
+            LeitorEntrada entrada("teste" + std::to_string(t + 1) + "_entrada.txt");
+            BaseDados& base = bases[t];
+            lerDados(entrada, base.corretores, base.clientes, base.imoveis, base.textos);
+        }
+        gerarBase(bases[4], 40, 6000, 12345u);
+
+        // As bases de teste, com as opções padrão, devem dar a saída esperada
+        for (int t = 0; t < 4; ++t) {
+            Caso caso{&bases[t], ParametrosAgenda(), ""};
+            if (executar(caso) != lerArquivo("teste" + std::to_string(t + 1) + "_saida.txt")) {
+                std::cerr << "teste" << t + 1 << ": saída diferente da esperada" << std::endl;
+                return 1;
+            }
+        }
+
+        // Referências de todas as combinações, calculadas numa thread só
+        std::vector<Caso> casos;
+        for (const auto& base : bases) {
+            for (int variante = 0; variante < 5; ++variante) {
+                Caso caso{&base, ParametrosAgenda(), ""};
+                if (variante == 1) {
+                    caso.parametros.rota.distancia = TipoDistancia::Cache;
+                } else if (variante == 2) {
+                    caso.parametros.rota.distancia = TipoDistancia::Equiretangular;
+                } else if (variante == 3) {
+                    caso.parametros.atribuicao = ModoAtribuicao::Cluster;
+                } else if (variante == 4) {
+                    caso.parametros.rota.tempo = ModeloTempo::PorTipo;
+                    caso.parametros.threads = 2;
+                }
+                caso.referencia = executar(caso);
+                casos.push_back(std::move(caso));
+            }
+        }
+
+        // Chamadas simultâneas: cada thread percorre os casos a partir de um ponto diferente
+        std::atomic<int> falhas(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int k = 0; k < chamadas; ++k) {
+                    const Caso& caso = casos[(t * 7 + k) % casos.size()];
+                    try {
+                        if (executar(caso) != caso.referencia) {
+                            falhas++;
+                        }
+                    } catch (const std::exception& e) {
+                        std::cerr << "thread " << t << ": " << e.what() << std::endl;
+                        falhas++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (falhas > 0) {
+            std::cerr << falhas << " de " << numThreads * chamadas << " chamadas divergiram" << std::endl;
+            return 1;
+        }
+
+        // Erros chegam como exceção, sem encerrar o processo
+        try {
+            agendarAvaliacoes(bases[0].corretores.data(), bases[0].corretores.size(), nullptr, 0);
+            std::cerr << "base sem imóveis foi aceita" << std::endl;
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+
+        std::cout << numThreads * chamadas << " chamadas simultâneas em " << numThreads
+                  << " threads conferem com a referência" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
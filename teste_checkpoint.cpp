@@ -0,0 +1,100 @@
+/**
+ * @file teste_checkpoint.cpp
+ * @brief Gera um checkpoint parcial para o teste de retomada e confere a soma de verificação
+ *
+ * Lê a base, repete a seleção, a distribuição e as rotas do programa com as
+ * opções padrão e grava um checkpoint em que só as rotas de índice par estão
+ * prontas, como se a execução tivesse sido interrompida. Retomando desse
+ * arquivo, o programa deve imprimir a mesma saída de uma execução sem
+ * interrupção (make test12).
+ *
+ * Antes, cada byte do arquivo é alterado numa cópia, que precisa ser
+ * recusada pelo carregamento.
+ *
+ * Uso: teste_checkpoint ENTRADA CHECKPOINT
+ * Termina com código 0 se tudo conferir e 1 caso contrário.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "checkpoint.h"
+#include "dados.h"
+#include "leitor.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Uso: teste_checkpoint ENTRADA CHECKPOINT" << std::endl;
+        return 1;
+    }
+    const std::string caminho = argv[2];
+    try {
+        BaseDados base;
+        LeitorEntrada entrada(argv[1]);
+        lerDados(entrada, base.corretores, base.clientes, base.imoveis, base.textos);
+        char programa[] = "imobiliaria";
+        char* argumentos[] = {programa};
+        Opcoes opcoes = lerOpcoes(1, argumentos);
+
+        // Mesmas etapas do programa, mas só as rotas pares ficam prontas
+        std::vector<const Corretor*> avaliadores = selecionarAvaliadores(base.corretores, base.imoveis);
+        std::uint64_t assinatura = assinaturaExecucao(base.corretores, base.imoveis, opcoes);
+        Atribuicao atribuicao = atribuirImoveis(base.imoveis, avaliadores, opcoes.atribuicao, opcoes.threads);
+        std::vector<std::vector<Agendamento>> agendas;
+        std::vector<std::uint32_t> rotas;
+        for (int k = 0; k < atribuicao.numAvaliadores(); ++k) {
+            if (atribuicao.imoveisDe(k).vazia()) {
+                continue;
+            }
+            if (agendas.size() % 2 == 0) {
+                rotas.push_back(static_cast<std::uint32_t>(agendas.size()));
+                agendas.push_back(gerarAgendamentoCorretor(base.imoveis, *atribuicao.avaliadores[k],
+                                                           atribuicao.imoveisDe(k), opcoes.rota));
+            } else {
+                agendas.emplace_back();
+            }
+        }
+        gravarCheckpoint(caminho, assinatura, EtapaRotas, atribuicao, agendas, rotas);
+
+        EstadoCheckpoint estado;
+        if (!carregarCheckpoint(caminho, assinatura, avaliadores, static_cast<int>(base.imoveis.size()), estado) ||
+            std::count(estado.prontas.begin(), estado.prontas.end(), 1) != static_cast<long>(rotas.size())) {
+            std::cerr << "checkpoint gravado não foi carregado" << std::endl;
+            return 1;
+        }
+
+        // Um bit trocado em qualquer posição precisa ser recusado
+        std::ifstream original(caminho, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+        const std::string corrompido = caminho + ".corrompido";
+        int aceitos = 0;
+        for (std::size_t posicao = 0; posicao < bytes.size(); ++posicao) {
+            std::vector<char> copia = bytes;
+            copia[posicao] ^= 0x10;
+            std::ofstream(corrompido, std::ios::binary).write(copia.data(), static_cast<std::streamsize>(copia.size()));
+            try {
+                EstadoCheckpoint lixo;
+                carregarCheckpoint(corrompido, assinatura, avaliadores, static_cast<int>(base.imoveis.size()), lixo);
+                std::cerr << "byte " << posicao << " alterado e o checkpoint foi aceito" << std::endl;
+                aceitos++;
+            } catch (const std::runtime_error&) {
+            }
+        }
+        std::remove(corrompido.c_str());
+        if (aceitos > 0) {
+            return 1;
+        }
+
+        std::cout << rotas.size() << " de " << agendas.size() << " rotas gravadas em " << caminho << "; "
+                  << bytes.size() << " alterações de um byte recusadas" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file textos.cpp
+ * @brief Implementação da arena de textos
+ */
+
+#include "textos.h"
+#include <cstring>
+#include <utility>
+
+ArenaTextos::ArenaTextos(std::size_t tamanhoBloco) : tamanhoBloco(tamanhoBloco) {
+}
+
+ArenaTextos::ArenaTextos(ArenaTextos&& outra) noexcept
+    : blocos(std::move(outra.blocos)), livre(outra.livre), restante(outra.restante),
+      tamanhoBloco(outra.tamanhoBloco), usados(outra.usados), alocados(outra.alocados) {
+    outra.blocos.clear();
+    outra.livre = nullptr;
+    outra.restante = outra.usados = outra.alocados = 0;
+}
+
+ArenaTextos& ArenaTextos::operator=(ArenaTextos&& outra) noexcept {
+    if (this != &outra) {
+        blocos = std::move(outra.blocos);
+        livre = outra.livre;
+        restante = outra.restante;
+        tamanhoBloco = outra.tamanhoBloco;
+        usados = outra.usados;
+        alocados = outra.alocados;
+        outra.blocos.clear();
+        outra.livre = nullptr;
+        outra.restante = outra.usados = outra.alocados = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Copia um texto para a arena
+ *
+ * Textos maiores que um quarto do bloco vão para um bloco só deles, para
+ * não desperdiçar o resto do bloco atual.
+ */
+std::string_view ArenaTextos::guardar(std::string_view texto) {
+    if (texto.empty()) {
+        return {};
+    }
+    char* destino;
+    if (texto.size() > tamanhoBloco / 4) {
+        blocos.emplace_back(new char[texto.size()]);
+        destino = blocos.back().get();
+        alocados += texto.size();
+    } else {
+        if (texto.size() > restante) {
+            blocos.emplace_back(new char[tamanhoBloco]);
+            livre = blocos.back().get();
+            restante = tamanhoBloco;
+            alocados += tamanhoBloco;
+        }
+        destino = livre;
+        livre += texto.size();
+        restante -= texto.size();
+    }
+    std::memcpy(destino, texto.data(), texto.size());
+    usados += texto.size();
+    return std::string_view(destino, texto.size());
+}
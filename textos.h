@@ -0,0 +1,65 @@
+/**
+ * @file textos.h
+ * @brief Arena para os textos da base (nomes, telefones e endereços)
+ *
+ * Em vez de cada Corretor, Cliente e Imovel ter seus próprios std::string
+ * (uma alocação por campo), os textos são copiados em sequência para
+ * blocos grandes e as entidades guardam std::string_view apontando para
+ * eles. Os blocos nunca são movidos nem liberados antes da arena, então as
+ * views continuam válidas mesmo quando a arena é movida (por exemplo, para
+ * dentro de AgendaIncremental).
+ *
+ * A arena deve viver pelo menos tanto quanto as entidades criadas com ela.
+ */
+
+#ifndef TEXTOS_H
+#define TEXTOS_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ArenaTextos
+ * @brief Armazena textos em blocos contíguos, sem liberação individual
+ */
+class ArenaTextos {
+public:
+    /**
+     * @param tamanhoBloco Bytes de cada bloco (textos maiores ganham um bloco próprio)
+     */
+    explicit ArenaTextos(std::size_t tamanhoBloco = 1 << 16);
+
+    /// A arena de origem fica vazia; as views já entregues continuam válidas
+    ArenaTextos(ArenaTextos&& outra) noexcept;
+    ArenaTextos& operator=(ArenaTextos&& outra) noexcept;
+    ArenaTextos(const ArenaTextos&) = delete;
+    ArenaTextos& operator=(const ArenaTextos&) = delete;
+
+    /**
+     * @brief Copia um texto para a arena
+     * @return View da cópia, válida enquanto a arena existir
+     */
+    std::string_view guardar(std::string_view texto);
+
+    /**
+     * @brief Bytes de texto guardados
+     */
+    std::size_t bytesUsados() const { return usados; }
+
+    /**
+     * @brief Bytes alocados em blocos (inclui o espaço ainda livre)
+     */
+    std::size_t bytesAlocados() const { return alocados; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocos;
+    char* livre = nullptr;        ///< Próximo byte livre do bloco atual
+    std::size_t restante = 0;     ///< Bytes livres no bloco atual
+    std::size_t tamanhoBloco;
+    std::size_t usados = 0;
+    std::size_t alocados = 0;
+};
+
+#endif